@@ -46,7 +46,7 @@ int main()
    auto view = doge::uniform(program, "view", false, glm::mat4{});
    auto model = doge::uniform(program, "model", false, glm::mat4{});
 
-   gl::Enable(gl::DEPTH_TEST);
+   doge::state_cache::enable(doge::capability::depth_test);
    doge::hid::mouse::sensitivity(0.4f);
    engine.play([&]{
       namespace hid = doge::hid;
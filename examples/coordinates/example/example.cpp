@@ -61,7 +61,7 @@ int main()
    doge::uniform(program, "view", false, glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, -3.0f}));
    auto model = doge::uniform(program, "model", false, glm::mat4{});
 
-   gl::Enable(gl::DEPTH_TEST);
+   doge::state_cache::enable(doge::capability::depth_test);
    engine.play([&]{
       doge::hid::on_key_press<doge::hid::keyboard>(GLFW_KEY_ESCAPE, [&engine]{ engine.close(); });
 
@@ -47,7 +47,7 @@ int main()
       engine.screen().aspect_ratio(), 0.1f, 100.0f));
    auto model = doge::uniform(program, "model", false, glm::mat4{});
 
-   gl::Enable(gl::DEPTH_TEST);
+   doge::state_cache::enable(doge::capability::depth_test);
    engine.play([&]{
       doge::hid::on_key_press<doge::hid::keyboard>(GLFW_KEY_ESCAPE, [&engine]{ engine.close(); });
 
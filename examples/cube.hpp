@@ -4,6 +4,7 @@
 #include "doge/doge.hpp"
 #include "static_objects.hpp"
 #include <string>
+#include <vector>
 
 namespace demo {
    class cube {
@@ -13,7 +14,8 @@ namespace demo {
          std::string const& basic_shader_path, std::string const& basic_map_path,
          Light const& light, std::string_view const light_position, std::string_view const ambient,
          std::string_view const diffuse, std::string_view const specular)
-         : vertices_{vertices},
+         : vertices_{doge::make_vertex_element_buffer(doge::optimise_mesh(vertices))},
+           models_{instance_models()},
            program_{doge::make_shader(basic_shader_path)},
            diffuse_map_{doge::make_texture_map<doge::texture_t::texture_2d>(basic_map_path + "_diffuse.png")},
            specular_map_{doge::make_texture_map<doge::texture_t::texture_2d>(basic_map_path + "_specular.png")},
@@ -22,6 +24,7 @@ namespace demo {
            diffuse_{program(), diffuse, light.diffuse()},
            specular_{program(), specular, light.specular()}
       {
+         vertices_.attach(models_);
          program_.use([&]{
             doge::uniform(program(), "material.diffuse", 0);
             doge::uniform(program(), "material.specular", 1);
@@ -52,12 +55,7 @@ namespace demo {
             diffuse_map_.bind(gl::TEXTURE0);
             specular_map_.bind(gl::TEXTURE1);
 
-            for (auto i = doge::zero(cube_positions); i < ranges::size(cube_positions); ++i) {
-               model_ = doge::mat4{1.0f}
-                      | doge::translate(cube_positions[i])
-                      | doge::rotate(doge::as_radians<float>(20.0f * i), {0.5f, 1.0f, 0.5f});
-               vertices_.draw([]{});
-            }
+            vertices_.draw_instanced(models_.size(), []{});
          });
       }
 
@@ -66,8 +64,9 @@ namespace demo {
          return program_;
       }
    private:
-      doge::vertex_array_buffer<doge::basic_buffer_usage::static_draw, doge::vec3, doge::vec3,
+      doge::vertex_element_buffer<doge::basic_buffer_usage::static_draw, doge::vec3, doge::vec3,
          doge::vec2> vertices_;
+      doge::instance_buffer<doge::basic_buffer_usage::static_draw, doge::mat4> models_;
       doge::shader_binary program_;
       doge::texture2d diffuse_map_;
       doge::texture2d specular_map_;
@@ -79,6 +78,19 @@ namespace demo {
       doge::uniform<doge::vec3> ambient_;
       doge::uniform<doge::vec3> diffuse_;
       doge::uniform<doge::vec3> specular_;
+
+      // Where each cube is placed. The vertex shader combines these with the model uniform.
+      static std::vector<doge::std_layout_tuple<doge::mat4>> instance_models()
+      {
+         auto result = std::vector<doge::std_layout_tuple<doge::mat4>>{};
+         result.reserve(ranges::size(cube_positions));
+         for (auto i = doge::zero(cube_positions); i < ranges::size(cube_positions); ++i) {
+            result.emplace_back(doge::mat4{1.0f}
+                              | doge::translate(cube_positions[i])
+                              | doge::rotate(doge::as_radians<float>(20.0f * i), {0.5f, 1.0f, 0.5f}));
+         }
+         return result;
+      }
    };
 } // namespace demo
 
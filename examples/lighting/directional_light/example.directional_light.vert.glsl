@@ -2,6 +2,7 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 normal;
 layout (location = 2) in vec2 texture_coordinates;
+layout (location = 3) in mat4 instance_model;
 
 out vec3 frag_position;
 out vec3 frag_normal;
@@ -13,8 +14,9 @@ uniform mat4 projection;
 
 void main()
 {
-   frag_position = vec3(model * vec4(position, 1.0));
-   frag_normal = mat3(transpose(inverse(model))) * normal;
+   mat4 world = model * instance_model;
+   frag_position = vec3(world * vec4(position, 1.0));
+   frag_normal = mat3(transpose(inverse(world))) * normal;
    frag_texture_coordinates = texture_coordinates;
    gl_Position = projection * view * vec4(frag_position, 1.0);
 }
@@ -18,6 +18,11 @@
 #include "doge/doge.hpp"
 #include <string>
 
+namespace {
+   // Hashed at compile time, so the per-frame lookup below doesn't touch any strings.
+   constexpr auto view_position = doge::resource_name{"view_position"};
+} // namespace <anonymous>
+
 class lamp {
 public:
    template <ranges::Invocable<doge::uniform<doge::mat4>&, doge::uniform<doge::mat4>&,
@@ -85,7 +90,7 @@ int main()
          light_position = light.position();
          model = doge::mat4{1.0f};
          projection = camera_projection;
-         doge::uniform(cube.program(), "view_position", camera.position());
+         doge::uniform(cube.program(), view_position, camera.position());
       }, light);
       l.draw([&](auto& projection, auto& view, auto& model){
          projection = camera_projection;
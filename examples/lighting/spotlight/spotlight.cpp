@@ -18,6 +18,12 @@
 #include "doge/doge.hpp"
 #include <string>
 
+namespace {
+   // Hashed at compile time, so the per-frame lookups below don't touch any strings.
+   constexpr auto view_position = doge::resource_name{"view_position"};
+   constexpr auto light_direction = doge::resource_name{"light.direction"};
+} // namespace <anonymous>
+
 int main()
 {
    auto engine = doge::engine{doge::depth_test::enabled};
@@ -67,8 +73,8 @@ int main()
          light_position = camera.position();
          model = doge::mat4{1.0f};
          projection = camera_projection;
-         doge::uniform(cube.program(), "view_position", camera.position());
-         doge::uniform(cube.program(), "light.direction", camera.direction());
+         doge::uniform(cube.program(), view_position, camera.position());
+         doge::uniform(cube.program(), light_direction, camera.direction());
       }, light);
    });
 }
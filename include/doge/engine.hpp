@@ -17,45 +17,311 @@
 #define DOGE_ENGINE_HPP
 
 #include <doge/hid.hpp>
+#include <doge/gl/gl_error.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <doge/hid/input_recording.hpp>
 #include <doge/types.hpp>
+#include <doge/utility/frame_limiter.hpp>
+#include <doge/utility/frame_pipeline.hpp>
+#include <doge/utility/job_system.hpp>
+#include <doge/utility/profiler.hpp>
 #include <doge/utility/screen_data.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
 #include <experimental/ranges/concepts>
 #include <experimental/ranges/functional>
 #include <gl/gl_core.hpp>
 #include <GLFW/glfw3.h>
+#include <gsl/gsl>
+#include <optional>
+#include <string>
+#include <thread>
 
 namespace doge {
    namespace ranges = std::experimental::ranges;
 
    enum class depth_test { disabled, enabled };
 
+   /// @brief Describes how often engine::play advances the simulation when it is decoupled from
+   /// the frame rate.
+   ///
+   class fixed_timestep {
+   public:
+      constexpr fixed_timestep() noexcept = default;
+
+      /// @param hertz The number of simulation steps per second.
+      /// @param max_steps The maximum number of steps that may be taken to catch up in a single
+      ///    frame. Any time beyond this is dropped so that a slow frame can't snowball.
+      ///
+      constexpr explicit fixed_timestep(double const hertz, int const max_steps = 5) noexcept
+         : step_{1.0 / hertz},
+           max_steps_{max_steps}
+      {
+         Expects(hertz > 0.0);
+         Expects(max_steps > 0);
+      }
+
+      [[nodiscard]] constexpr double step() const noexcept
+      {
+         return step_;
+      }
+
+      [[nodiscard]] constexpr int max_steps() const noexcept
+      {
+         return max_steps_;
+      }
+
+      /// @brief Takes the steps that are due out of accumulator, which holds the simulation time
+      ///    that hasn't been stepped through yet.
+      /// @returns The number of steps to take, which is at most max_steps(). If that isn't enough
+      ///    to catch up, everything but the partial step that's left over is dropped.
+      ///
+      int consume(double& accumulator) const noexcept
+      {
+         auto steps = 0;
+         for (; accumulator >= step_ && steps < max_steps_; ++steps)
+            accumulator -= step_;
+
+         if (accumulator >= step_)
+            accumulator = std::fmod(accumulator, step_);
+
+         return steps;
+      }
+   private:
+      double step_ = 1.0 / 60.0;
+      int max_steps_ = 5;
+   };
+
+   /// @brief Selects the pipelined overload of engine::play.
+   /// @tparam Frame The packet that game logic fills in for the render thread each frame (e.g.
+   ///    camera matrices, a draw list, and uniform values).
+   ///
+   template <ranges::Semiregular Frame>
+   struct pipelined_t {
+      explicit pipelined_t() = default;
+   };
+
+   template <ranges::Semiregular Frame>
+   inline constexpr auto pipelined = pipelined_t<Frame>{};
+
+   /// @brief Owns the screen and runs the game loop.
+   /// @note Setting the environment variable DOGE_RECORD_INPUT to a path records all input to that
+   ///    file, and setting DOGE_REPLAY_INPUT replays such a file instead of reading live input.
+   ///
    class engine {
    public:
       engine(depth_test const enable_depth_test = depth_test::disabled)
          : clear_flags_{set_clear_flags(static_cast<bool>(enable_depth_test))}
       {
-         doge::hid::keyboard::init(screen_.window()); // TODO get this into a constructor >:(
-         doge::hid::mouse::init(screen_.window()); // TODO get this into a constructor >:(
+         if (not screen_.headless()) {
+            doge::hid::keyboard::init(screen_.window()); // TODO get this into a constructor >:(
+            doge::hid::mouse::init(screen_.window()); // TODO get this into a constructor >:(
+         }
+
+         // The policy can only be applied once there's a context, so this applies the one that
+         // was chosen beforehand (by default, default_error_policy).
+         error_checking::policy(error_checking::policy());
+
+         if (auto const path = std::getenv("DOGE_REPLAY_INPUT"))
+            replay_input(path);
+         else if (auto const path = std::getenv("DOGE_RECORD_INPUT"))
+            record_input(path);
       }
 
       template <ranges::Invocable F>
       void play(F const& logic)
       {
-         while (screen_.open()) {
-            compute_frame_displacement();
+         while (screen_.open() && compute_frame_displacement()) {
+            profiler_.begin_frame();
             clear_screen();
             ranges::invoke(logic);
+            jobs_.wait_for_frame();
             hid::mouse::update();
+            profiler_.end_frame();
+            error_checking::check_frame();
+            screen_.swap_buffers();
+            limiter_.pace();
+            poll_events();
+         }
+      }
+
+      /// @brief Runs the simulation at a constant rate, independently of the rendering rate.
+      /// @param timestep The rate at which update is invoked.
+      /// @param update Advances the simulation by exactly timestep.step() seconds. It is invoked
+      ///    zero or more times per frame, and frame_displacement() reports the step size.
+      /// @param render Draws the frame. It is invoked once per frame with the fraction of a step
+      ///    that has elapsed since the last update, which can be used to interpolate between the
+      ///    previous and current simulation states.
+      ///
+      template <ranges::Invocable Update, ranges::Invocable<float> Render>
+      void play(fixed_timestep const timestep, Update const& update, Render const& render)
+      {
+         ranges::Regular accumulator = 0.0;
+         previous_frame_ = time();
+         frame_displacement_ = gsl::narrow_cast<float>(timestep.step());
+
+         while (screen_.open()) {
+            auto const delta = next_frame_delta();
+            if (not delta)
+               break;
+
+            accumulator += *delta;
+            profiler_.begin_frame();
+
+            for (auto steps = timestep.consume(accumulator); steps > 0; --steps) {
+               ranges::invoke(update);
+               jobs_.wait_for_frame();
+               hid::mouse::update();
+            }
+
+            clear_screen();
+            ranges::invoke(render, gsl::narrow_cast<float>(accumulator / timestep.step()));
+            jobs_.wait_for_frame();
+            profiler_.end_frame();
+            error_checking::check_frame();
             screen_.swap_buffers();
-            glfwPollEvents();
+            limiter_.pace();
+            poll_events();
          }
       }
 
+      /// @brief Overlaps game logic with rendering by moving the GL context onto a render thread.
+      ///
+      /// logic runs on the calling thread and writes frame N into a double-buffered Frame, while
+      /// render draws frame N - 1 on the render thread. Since the context is owned by the render
+      /// thread, logic must not make any GL calls (this includes assigning to a doge::uniform):
+      /// anything that the GPU needs must travel through the Frame. For the same reason, profiled
+      /// scopes may only be opened in render. Jobs spawned by render must be waited on with
+      /// job_system::wait, as only logic's frame is waited on by play.
+      ///
+      template <ranges::Semiregular Frame, ranges::Invocable<Frame&> Logic,
+         ranges::Invocable<Frame const&> Render>
+      void play(pipelined_t<Frame>, Logic const& logic, Render const& render)
+      {
+         auto frames = frame_pipeline<Frame>{};
+         auto render_error = std::exception_ptr{};
+
+         screen_.release_context();
+         auto renderer = std::thread{[this, &frames, &render, &render_error]{
+            screen_.make_context_current();
+            try {
+               while (frames.consume([this, &render](Frame const& frame) {
+                  profiler_.begin_frame();
+                  clear_screen();
+                  ranges::invoke(render, frame);
+                  profiler_.end_frame();
+                  error_checking::check_frame();
+                  screen_.swap_buffers();
+               })) {}
+            }
+            catch (...) {
+               render_error = std::current_exception();
+               frames.close();
+            }
+            screen_.release_context();
+         }};
+
+         auto const join = [&frames, &renderer, this]{
+            frames.close();
+            renderer.join();
+            screen_.make_context_current();
+         };
+
+         try {
+            while (screen_.open() && compute_frame_displacement()) {
+               ranges::invoke(logic, frames.back());
+               jobs_.wait_for_frame();
+               hid::mouse::update();
+               if (not frames.publish())
+                  break;
+               limiter_.pace();
+               poll_events();
+            }
+         }
+         catch (...) {
+            join();
+            throw;
+         }
+
+         join();
+         if (render_error)
+            std::rethrow_exception(render_error);
+      }
+
       const screen_data& screen() const noexcept
       {
          return screen_;
       }
 
+      /// @brief The engine's job system. Logic may spawn jobs from here: play waits for all of them
+      ///    to finish before the frame ends.
+      ///
+      job_system& jobs() noexcept
+      {
+         return jobs_;
+      }
+
+      /// @brief Holds play to the rate that limiter targets. By default, play isn't limited.
+      ///
+      /// The limiter waits after each frame is presented and before input is polled, so a
+      /// just_in_time limiter also delays input sampling and logic.
+      ///
+      void frame_limit(doge::frame_limiter const& limiter) noexcept
+      {
+         limiter_ = limiter;
+      }
+
+      /// @brief The current limiter, including how well the last frame was paced.
+      ///
+      doge::frame_limiter const& frame_limit() const noexcept
+      {
+         return limiter_;
+      }
+
+      /// @brief Per-frame CPU/GPU timings for the frames that play has run so far.
+      ///
+      doge::profiler& profiler() noexcept
+      {
+         return profiler_;
+      }
+
+      doge::profiler const& profiler() const noexcept
+      {
+         return profiler_;
+      }
+
+      /// @brief Changes when GL errors are looked for. The default is default_error_policy.
+      ///
+      /// Errors that are found at the end of a frame are thrown out of play.
+      ///
+      void error_policy(doge::error_policy const p)
+      {
+         error_checking::policy(p);
+      }
+
+      /// @brief Writes all input, and the length of every frame, to the file at path.
+      /// @throws std::runtime_error if path can't be opened.
+      ///
+      void record_input(std::string const& path)
+      {
+         input_player_.reset();
+         input_recorder_.emplace(path);
+      }
+
+      /// @brief Replays a file written by record_input, in place of live input.
+      ///
+      /// Frame displacements are taken from the file, rather than measured, so the replay is
+      /// frame-exact. The screen closes when the recording runs out.
+      /// @throws std::runtime_error if path can't be read, or isn't an input recording.
+      ///
+      void replay_input(std::string const& path)
+      {
+         input_recorder_.reset();
+         input_player_.emplace(path);
+      }
+
       void close() noexcept
       {
          screen_.close();
@@ -81,31 +347,78 @@ namespace doge {
       {
          return frame_displacement_;
       }
+
+      /// @brief The number of seconds since the engine's clock started.
+      /// @note Unlike glfwGetTime, this doesn't depend on GLFW being initialised, and so it is
+      ///    also available when the screen is headless.
+      ///
+      [[nodiscard]] static double time() noexcept
+      {
+         using seconds = std::chrono::duration<double>;
+         return seconds{std::chrono::steady_clock::now() - epoch_}.count();
+      }
    private:
       screen_data screen_;
+      doge::profiler profiler_;
+      job_system jobs_;
+      doge::frame_limiter limiter_;
+      std::optional<hid::input_recorder> input_recorder_;
+      std::optional<hid::input_player> input_player_;
       vec4 clear_colour_ = {1.0f, 1.0f, 1.0f, 1.0f};
       GLenum clear_flags_;
 
-      static inline float previous_frame_ = glfwGetTime();
+      static inline auto const epoch_ = std::chrono::steady_clock::now();
+      static inline double previous_frame_ = time();
       static inline float frame_displacement_ = 0.0f;
 
       static GLenum set_clear_flags(bool const depth_buffer) noexcept
       {
          auto flags = GLenum{gl::COLOR_BUFFER_BIT};
          if (depth_buffer) {
-            gl::Enable(gl::DEPTH_TEST);
+            state_cache::enable(capability::depth_test);
             flags |= gl::DEPTH_BUFFER_BIT;
          }
 
          return flags;
       }
 
-      static void compute_frame_displacement() noexcept
+      /// @brief The number of seconds since the previous frame, or the recorded number when input is
+      ///    being replayed.
+      /// @returns std::nullopt if a replay has run out of frames.
+      ///
+      std::optional<double> next_frame_delta()
       {
-         ranges::Regular const current_frame = glfwGetTime();
+         ranges::Regular const current_frame = time();
          ranges::Regular const displacement = current_frame - previous_frame_;
          previous_frame_ = current_frame;
-         frame_displacement_ = displacement;
+
+         if (input_player_) {
+            auto const recorded = input_player_->next_frame();
+            if (not recorded)
+               screen_.close();
+            return recorded;
+         }
+
+         if (input_recorder_)
+            input_recorder_->frame(displacement);
+         return displacement;
+      }
+
+      /// @returns false if a replay has run out of frames, true otherwise.
+      ///
+      bool compute_frame_displacement()
+      {
+         auto const displacement = next_frame_delta();
+         if (displacement)
+            frame_displacement_ = gsl::narrow_cast<float>(*displacement);
+         return displacement.has_value();
+      }
+
+      void poll_events()
+      {
+         screen_.poll_events();
+         if (input_player_)
+            input_player_->poll_events();
       }
    };
 } // namespace doge
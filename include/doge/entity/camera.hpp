@@ -24,6 +24,7 @@
 #include <experimental/ranges/concepts>
 #include <glm/gtc/matrix_transform.hpp>
 #include <gsl/gsl>
+#include <limits>
 
 namespace doge {
    namespace ranges = std::experimental::ranges;
@@ -62,6 +63,21 @@ namespace doge {
          return glm::perspective(gsl::narrow_cast<float>(field_of_view_), aspect_ratio, min_view,
             max_view);
       }
+
+      /// @brief How many pixels one unit covers at point, once it's projected onto a viewport
+      ///    that's viewport_height pixels tall. Multiplying by an object's size gives its size on
+      ///    screen, which is what select_lod() uses to pick a level of detail.
+      ///
+      [[nodiscard]] float pixels_per_unit(vec3 const& point, float const viewport_height) const
+         noexcept
+      {
+         auto const distance = glm::length(point - position());
+         if (distance <= 0.0f)
+            return std::numeric_limits<float>::max();
+
+         auto const half_height = std::tan(gsl::narrow_cast<float>(field_of_view_) / 2.0f);
+         return viewport_height / (2.0f * distance * half_height);
+      }
    private:
       angle field_of_view_ = 45.0_deg;
    };
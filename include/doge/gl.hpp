@@ -17,11 +17,21 @@
 #define DOGE_GL_HPP
 
 #include "doge/gl/cast.hpp"
+#include "doge/gl/direct_state_access.hpp"
 #include "doge/gl/gl_error.hpp"
+#include "doge/gl/indirect_batch.hpp"
+#include "doge/gl/mesh_heap.hpp"
+#include "doge/gl/packed_attributes.hpp"
+#include "doge/gl/program_reflection.hpp"
+#include "doge/gl/render_queue.hpp"
 #include "doge/gl/shader_binary.hpp"
 #include "doge/gl/shader_source.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/gl/streaming_buffer.hpp"
 #include "doge/gl/texture.hpp"
 #include "doge/gl/uniform.hpp"
+#include "doge/gl/uniform_block.hpp"
+#include "doge/gl/uniform_uploads.hpp"
 #include "doge/gl/vertex_array.hpp"
 
 #include "doge/glm/matrix.hpp"
@@ -16,11 +16,22 @@
 #ifndef DOGE_GL_VERTEX_BUFFER_HPP
 #define DOGE_GL_VERTEX_BUFFER_HPP
 
+#include "doge/gl/direct_state_access.hpp"
 #include "doge/gl/memory.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/utility/dirty_ranges.hpp"
 #include "doge/utility/std_layout_tuple.hpp"
+#include "doge/utility/type_traits.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <experimental/ranges/algorithm>
 #include <experimental/ranges/iterator>
 #include <gl/gl_core.hpp>
 #include <gsl/gsl>
+#include <limits>
+#include <tuple>
+#include <vector>
 
 #pragma GCC diagnostic push 
 #pragma GCC diagnostic ignored "-Wsign-compare"
@@ -36,6 +47,7 @@ namespace doge {
       array = gl::ARRAY_BUFFER,
       element_array = gl::ELEMENT_ARRAY_BUFFER,
       uniform = gl::UNIFORM_BUFFER,
+      shader_storage = gl::SHADER_STORAGE_BUFFER,
    };
 
    /// @brief Determines how the buffer will be typically used.
@@ -64,6 +76,44 @@ namespace doge {
       structure_of_arrays
    };
 
+   namespace detail {
+      template <typename Index>
+      requires
+         is_one_of_v<Index, GLubyte, GLushort, GLuint>
+      inline constexpr GLenum index_type_v = std::is_same_v<Index, GLubyte> ? gl::UNSIGNED_BYTE
+                                           : std::is_same_v<Index, GLushort> ? gl::UNSIGNED_SHORT
+                                           : gl::UNSIGNED_INT;
+
+      template <typename Index>
+      bool indices_fit(gsl::span<GLuint const> const elements) noexcept
+      {
+         return ranges::all_of(elements, [](GLuint const e) {
+            return e <= std::numeric_limits<Index>::max(); });
+      }
+
+      template <typename Index>
+      std::vector<Index> narrow_indices(gsl::span<GLuint const> const elements)
+      {
+         Expects(indices_fit<Index>(elements));
+         auto result = std::vector<Index>(ranges::size(elements));
+         ranges::transform(elements, ranges::begin(result), [](GLuint const e) {
+            return gsl::narrow_cast<Index>(e); });
+         return result;
+      }
+
+      inline std::size_t index_size(GLenum const index_type) noexcept
+      {
+         switch (index_type) {
+         case gl::UNSIGNED_BYTE:
+            return sizeof(GLubyte);
+         case gl::UNSIGNED_SHORT:
+            return sizeof(GLushort);
+         default:
+            return sizeof(GLuint);
+         }
+      }
+   } // namespace detail
+
    /// @brief 
    /// @tparam Resource Determines the operations that the 
    /// @tparam T
@@ -71,12 +121,40 @@ namespace doge {
    /// @tparam Layout
    /// @tparam Types...
    ///
+   /// Array-of-structures buffers keep their storage between writes. A write that fits in the
+   /// current capacity is uploaded in place, and one that doesn't orphans the storage and at least
+   /// doubles it, so a buffer that's rewritten with slowly growing data is only reallocated a
+   /// logarithmic number of times.
+   ///
+   /// Writes to part of a buffer are staged on the CPU instead, and are merged with the other
+   /// pending writes that they overlap or touch. flush() uploads them all at once.
+   ///
+   /// Structure-of-arrays buffers keep each member in a buffer of its own, called a stream. Each
+   /// stream has its own capacity, and can be rewritten without touching the others, so that an
+   /// animated mesh only uploads the positions that changed.
+   ///
+   /// Element array buffers store GLuint indices as GLushorts whenever they all fit, and draws
+   /// use index_type() to read them.
+   ///
+   /// Without direct state access, every upload binds the buffer to GL_COPY_WRITE_BUFFER rather
+   /// than to its own target, so that writing an element array buffer doesn't replace the current
+   /// vertex array's element buffer.
+   ///
    template <resource_type Resource, basic_buffer_type T, basic_buffer_usage Usage,
       basic_buffer_layout Layout = basic_buffer_layout::array_of_structures, typename... Types>
    requires
       (StandardLayout<Types> && ...)
    class basic_buffer {
    public:
+      /// @brief The number of GL buffers that hold the data: one per member for a structure of
+      ///    arrays, and one otherwise.
+      ///
+      static constexpr std::size_t streams =
+         Layout == basic_buffer_layout::array_of_structures ? 1 : sizeof...(Types);
+
+      template <std::size_t I>
+      using stream_type = std::tuple_element_t<I, std::tuple<Types...>>;
+
       /// @brief Writes data to the buffer.
       ///
       /// TODO: add more
@@ -100,8 +178,9 @@ namespace doge {
       /// @tparam UTypes...
       /// @param utypes...
       /// @note Only participates in overload resolution if sizeof...(Types) == sizeof...(UTypes),
-      ///    Layout == basic_buffer_layout::structure_of_arrays, for each U in UTypes is a
-      ///    contiguous range and for each T in Types, T is constructible from U.
+      ///    Layout == basic_buffer_layout::structure_of_arrays, and each U in UTypes is a
+      ///    contiguous range. Each range's values are uploaded as they are, so for each [T, U] in
+      ///    (Types, UTypes), U's value type must be T.
       ///
       template <typename... UTypes>
       requires
@@ -110,23 +189,175 @@ namespace doge {
          (ranges::ext::ContiguousRange<UTypes> && ...)
       void write(UTypes&&... utypes) noexcept
       {
-         static_assert((ranges::Constructible<Types, UTypes> && ...));
-         write_impl(std::forward<UTypes>(utypes)..., std::index_sequence_for<UTypes...>{});
+         static_assert((ranges::Same<Types, ranges::value_type_t<std::decay_t<UTypes>>> && ...));
+         write_streams(std::index_sequence_for<UTypes...>{}, utypes...);
+      }
+
+      /// @brief Replaces stream I, leaving the other streams alone.
+      ///
+      template <std::size_t I>
+      requires
+         Layout == basic_buffer_layout::structure_of_arrays &&
+         I < sizeof...(Types)
+      void write(gsl::span<stream_type<I> const> const data) noexcept
+      {
+         write_impl<sizeof(stream_type<I>)>(data, I);
       }
 
-      /// @brief
-      /// @param
+      /// @brief Replaces the values of stream I starting at index first. Unlike partial writes to an
+      ///    array-of-structures buffer, they're uploaded straight away, since each stream is
+      ///    usually rewritten in one piece.
+      /// @note first + size(data) values must already be in the stream.
+      ///
+      template <std::size_t I>
+      requires
+         Layout == basic_buffer_layout::structure_of_arrays &&
+         I < sizeof...(Types)
+      void write(std::size_t const first, gsl::span<stream_type<I> const> const data) noexcept
+      {
+         constexpr auto size = sizeof(stream_type<I>);
+         auto const bytes = ranges::size(data) * size;
+         Expects(first * size + bytes <= sizes_[I]);
+         if (bytes > 0)
+            sub_data(first * size, bytes, ranges::data(data), I);
+      }
+
+      /// @brief Replaces the buffer's elements, storing them as GLushorts if every index fits in
+      ///    one, which halves both the buffer and the bandwidth that fetching indices takes.
+      ///
       void write(gsl::span<GLuint const> const elements) noexcept
       requires
          T == basic_buffer_type::element_array
       {
+         if (detail::indices_fit<GLushort>(elements)) {
+            write(gsl::span<GLushort const>{detail::narrow_indices<GLushort>(elements)});
+            return;
+         }
+
+         index_type_ = gl::UNSIGNED_INT;
          write_impl<sizeof(GLuint)>(elements);
       }
 
+      /// @brief Replaces the buffer's elements with indices that are already narrower than GLuint.
+      /// @note GLubyte indices are only ever used when they're asked for, since many drivers widen
+      ///    them on the CPU before drawing.
+      ///
+      template <typename Index>
+      requires
+         T == basic_buffer_type::element_array &&
+         is_one_of_v<Index, GLubyte, GLushort>
+      void write(gsl::span<Index const> const elements) noexcept
+      {
+         index_type_ = detail::index_type_v<Index>;
+         write_impl<sizeof(Index)>(elements);
+      }
+
+      /// @brief Replaces the elements of the buffer starting at index first with data.
+      ///
+      /// The data is staged until flush() is called, so that several small writes are uploaded
+      /// together.
+      /// @note first + size(data) elements must already be in the buffer.
+      ///
+      template <typename... UTypes>
+      requires
+         sizeof...(Types) == sizeof...(UTypes) &&
+         Layout == basic_buffer_layout::array_of_structures
+      void write(std::size_t const first, gsl::span<std_layout_tuple<UTypes...> const> const data)
+      {
+         static_assert((ranges::Constructible<Types, UTypes> && ...));
+         stage<(sizeof(UTypes) + ...)>(first, data);
+      }
+
+      /// @copydoc write(std::size_t, gsl::span<std_layout_tuple<UTypes...> const>)
+      /// @note The elements are stored at the buffer's current index_type() if they all fit in it.
+      ///    Otherwise, the buffer is read back, and rewritten as a whole with indices that are wide
+      ///    enough, which waits for the GPU to finish with it. index_type() changes accordingly.
+      ///
+      void write(std::size_t const first, gsl::span<GLuint const> const elements)
+      requires
+         T == basic_buffer_type::element_array
+      {
+         switch (index_type_) {
+         case gl::UNSIGNED_BYTE:
+            if (detail::indices_fit<GLubyte>(elements)) {
+               stage<sizeof(GLubyte)>(first, gsl::span<GLubyte const>{
+                  detail::narrow_indices<GLubyte>(elements)});
+               return;
+            }
+            break;
+         case gl::UNSIGNED_SHORT:
+            if (detail::indices_fit<GLushort>(elements)) {
+               stage<sizeof(GLushort)>(first, gsl::span<GLushort const>{
+                  detail::narrow_indices<GLushort>(elements)});
+               return;
+            }
+            break;
+         default:
+            stage<sizeof(GLuint)>(first, elements);
+            return;
+         }
+
+         auto indices = read_indices();
+         Expects(first + ranges::size(elements) <= ranges::size(indices));
+         ranges::copy(elements, ranges::begin(indices) + gsl::narrow_cast<std::ptrdiff_t>(first));
+         write(gsl::span<GLuint const>{indices});
+      }
+
+      /// @brief Uploads the partial writes that have been staged since the last flush.
+      ///
+      /// A few ranges are each uploaded with glBufferSubData. Many ranges share a single mapping of
+      /// the span that covers them, and only the ranges themselves are flushed to the GPU.
+      ///
+      void flush() noexcept
+      requires
+         Layout == basic_buffer_layout::array_of_structures
+      {
+         if (dirty_.empty())
+            return;
+
+         if (dirty_.size() < map_threshold) {
+            dirty_.for_each([this](std::size_t const offset, gsl::span<std::byte const> const bytes) {
+               sub_data(offset, ranges::size(bytes), ranges::data(bytes));
+            });
+         }
+         else {
+            map_dirty_ranges();
+         }
+
+         dirty_.clear();
+      }
+
+      /// @brief The number of bytes that were last written to the buffer, or to one of its streams,
+      ///    as a whole.
+      ///
+      [[nodiscard]] std::size_t size(std::size_t const stream = 0) const noexcept
+      {
+         Expects(stream < streams);
+         return sizes_[stream];
+      }
+
+      /// @brief The number of bytes that the buffer, or one of its streams, can hold before it
+      ///    needs to be reallocated.
+      ///
+      [[nodiscard]] std::size_t capacity(std::size_t const stream = 0) const noexcept
+      {
+         Expects(stream < streams);
+         return capacities_[stream];
+      }
+
+      /// @brief The type that the elements are stored as, which draws must pass to glDrawElements.
+      ///
+      [[nodiscard]] GLenum index_type() const noexcept
+      requires
+         T == basic_buffer_type::element_array
+      {
+         return index_type_;
+      }
+
       GLuint operator[](int const i) const noexcept
       {
          Expects(i >= 0);
-         return buffer_[i];
+         return buffer_.get()[i];
       }
 
       ranges::RandomAccessRange const& get() const noexcept
@@ -134,28 +365,150 @@ namespace doge {
          return buffer_.get();
       }
    private:
-      gpu_ptr<Resource,
-         Layout == basic_buffer_layout::array_of_structures ? 1 : sizeof...(Types)> buffer_;
+      gpu_ptr<Resource, streams> buffer_;
+      std::array<std::size_t, streams> sizes_ = {};
+      std::array<std::size_t, streams> capacities_ = {};
+      dirty_ranges dirty_;
+      GLenum index_type_ = gl::UNSIGNED_INT;
+
+      // The number of staged ranges at which flush() maps the buffer instead of uploading each
+      // range separately.
+      static constexpr std::size_t map_threshold = 4;
 
       template <std::size_t Size, typename U>
-      void write_impl(gsl::span<U const> const data) noexcept
+      void write_impl(gsl::span<U const> const data, std::size_t const stream = 0) noexcept
       {
-         constexpr ranges::UnsignedIntegral type = static_cast<GLuint>(T);
-         gl::BindBuffer(type, *buffer_);
-         gl::BufferData(type, ranges::size(data) * Size, ranges::data(data), static_cast<GLuint>(Usage));
+         // The whole buffer is being replaced, so nothing that's staged is still wanted.
+         if constexpr (Layout == basic_buffer_layout::array_of_structures)
+            dirty_.clear();
+
+         auto const bytes = ranges::size(data) * Size;
+         auto& capacity = capacities_[stream];
+         if (bytes > capacity) {
+            capacity = std::max(bytes, 2 * capacity);
+            if (capacity == bytes) {
+               sizes_[stream] = bytes;
+               allocate(ranges::data(data), stream);
+               return;
+            }
+
+            allocate(nullptr, stream);
+         }
+
+         sizes_[stream] = bytes;
+         if (bytes > 0)
+            sub_data(0, bytes, ranges::data(data), stream);
       }
 
-      template <typename... UTypes, std::size_t... IndexSequence>
-      requires
-         Layout == basic_buffer_layout::structure_of_arrays
-      void write_impl(UTypes&&... utypes, std::index_sequence<IndexSequence...>)
-      {
-         static_assert((ranges::ext::ContiguousRange<UTypes> && ...));
-         static_asserT((ranges::Constructible<Types, UTypes> && ...));
-         constexpr ranges::UnsignedIntegral type = static_cast<GLuint>(T);
-         ((gl::BindBuffer(type, buffer_[IndexSequence]),
-           gl::BufferData(type, ranges::size(utypes) * sizeof(ranges::value_type_t<std::decay_t<UTypes>>),
-              ranges::data(utypes), static_cast<GLuint>(Usage))), ...);
+      template <std::size_t... I, typename... UTypes>
+      void write_streams(std::index_sequence<I...>, UTypes const&... utypes) noexcept
+      {
+         (write<I>(gsl::span<stream_type<I> const>{utypes}), ...);
+      }
+
+      template <std::size_t Size, typename U>
+      void stage(std::size_t const first, gsl::span<U const> const data)
+      {
+         auto const bytes = ranges::size(data) * Size;
+         Expects((first * Size) + bytes <= sizes_[0]);
+         dirty_.add(first * Size,
+            {reinterpret_cast<std::byte const*>(ranges::data(data)),
+             gsl::narrow_cast<std::ptrdiff_t>(bytes)});
+      }
+
+      // Replaces a stream's storage with its capacity, orphaning the old storage, so that draws
+      // which are still reading it don't stall the upload.
+      void allocate(void const* const data, std::size_t const stream = 0) noexcept
+      {
+         auto const buffer = buffer_.get()[stream];
+         auto const bytes = gsl::narrow_cast<GLsizeiptr>(capacities_[stream]);
+         if (direct_state_access::enabled()) {
+            gl::NamedBufferData(buffer, bytes, data, static_cast<GLuint>(Usage));
+            return;
+         }
+
+         state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, buffer);
+         gl::BufferData(gl::COPY_WRITE_BUFFER, bytes, data, static_cast<GLuint>(Usage));
+      }
+
+      void sub_data(std::size_t const offset, std::size_t const bytes, void const* const data,
+         std::size_t const stream = 0) noexcept
+      {
+         auto const buffer = buffer_.get()[stream];
+         if (direct_state_access::enabled()) {
+            gl::NamedBufferSubData(buffer, gsl::narrow_cast<GLintptr>(offset),
+               gsl::narrow_cast<GLsizeiptr>(bytes), data);
+            return;
+         }
+
+         state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, buffer);
+         gl::BufferSubData(gl::COPY_WRITE_BUFFER, gsl::narrow_cast<GLintptr>(offset),
+            gsl::narrow_cast<GLsizeiptr>(bytes), data);
+      }
+
+      // Reads the elements back from the GPU, including any partial writes that were staged, and
+      // widens them to GLuint.
+      std::vector<GLuint> read_indices()
+      {
+         flush();
+         switch (index_type_) {
+         case gl::UNSIGNED_BYTE:
+            return read_indices<GLubyte>();
+         case gl::UNSIGNED_SHORT:
+            return read_indices<GLushort>();
+         default:
+            return read_indices<GLuint>();
+         }
+      }
+
+      template <typename Index>
+      std::vector<GLuint> read_indices() const
+      {
+         auto result = std::vector<Index>(sizes_[0] / sizeof(Index));
+         auto const bytes = gsl::narrow_cast<GLsizeiptr>(sizes_[0]);
+         if (direct_state_access::enabled()) {
+            gl::GetNamedBufferSubData(*buffer_, 0, bytes, ranges::data(result));
+         }
+         else {
+            state_cache::bind_buffer(gl::COPY_READ_BUFFER, *buffer_);
+            gl::GetBufferSubData(gl::COPY_READ_BUFFER, 0, bytes, ranges::data(result));
+         }
+
+         return {ranges::begin(result), ranges::end(result)};
+      }
+
+      void map_dirty_ranges() noexcept
+      {
+         constexpr auto flags = GLbitfield{gl::MAP_WRITE_BIT | gl::MAP_FLUSH_EXPLICIT_BIT};
+         auto const first = dirty_.first();
+         auto const length = gsl::narrow_cast<GLsizeiptr>(dirty_.last() - first);
+         auto const dsa = direct_state_access::enabled();
+
+         auto* mapped = static_cast<std::byte*>(nullptr);
+         if (dsa) {
+            mapped = static_cast<std::byte*>(gl::MapNamedBufferRange(*buffer_,
+               gsl::narrow_cast<GLintptr>(first), length, flags));
+         }
+         else {
+            state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *buffer_);
+            mapped = static_cast<std::byte*>(gl::MapBufferRange(gl::COPY_WRITE_BUFFER,
+               gsl::narrow_cast<GLintptr>(first), length, flags));
+         }
+
+         dirty_.for_each([=](std::size_t const offset, gsl::span<std::byte const> const bytes) {
+            auto const relative = gsl::narrow_cast<GLintptr>(offset - first);
+            auto const size = gsl::narrow_cast<GLsizeiptr>(ranges::size(bytes));
+            std::memcpy(mapped + relative, ranges::data(bytes), ranges::size(bytes));
+            if (dsa)
+               gl::FlushMappedNamedBufferRange(*buffer_, relative, size);
+            else
+               gl::FlushMappedBufferRange(gl::COPY_WRITE_BUFFER, relative, size);
+         });
+
+         if (dsa)
+            gl::UnmapNamedBuffer(*buffer_);
+         else
+            gl::UnmapBuffer(gl::COPY_WRITE_BUFFER);
       }
    };
 
@@ -0,0 +1,57 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_DIRECT_STATE_ACCESS_HPP
+#define DOGE_GL_DIRECT_STATE_ACCESS_HPP
+
+#include <gl/gl_core.hpp>
+
+namespace doge {
+   /// @brief Decides how doge edits buffers, vertex arrays, and textures.
+   ///
+   /// When the context supports GL 4.5's direct state access (or ARB_direct_state_access), objects
+   /// are created with glCreate* and edited through their names, so updating a resource never
+   /// disturbs the bindings that draws depend on. Otherwise, doge binds an object before editing
+   /// it, as GL 3.3 requires.
+   ///
+   class direct_state_access {
+   public:
+      [[nodiscard]] static bool supported() noexcept
+      {
+         auto const& extension = gl::exts::var_ARB_direct_state_access;
+         return extension && extension.GetNumMissing() == 0;
+      }
+
+      [[nodiscard]] static bool enabled() noexcept
+      {
+         return enabled_ && supported();
+      }
+
+      /// @brief Forces the bind-to-edit path when e is false, even if direct state access is
+      ///    supported.
+      /// @note Textures that are generated while this is off don't become objects until they're
+      ///    first bound, so it's only safe to turn back on once every existing texture has been
+      ///    written. Other objects come from a name_pool, which always creates them.
+      ///
+      static void enabled(bool const e) noexcept
+      {
+         enabled_ = e;
+      }
+   private:
+      static inline bool enabled_ = true;
+   };
+} // namespace doge
+
+#endif // DOGE_GL_DIRECT_STATE_ACCESS_HPP
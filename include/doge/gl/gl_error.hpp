@@ -15,10 +15,14 @@
 //
 #ifndef DOGE_GL_GL_ERROR_HPP
 #define DOGE_GL_GL_ERROR_HPP
+#include <cstddef>
 #include <gl/gl_core.hpp>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace doge {
    class invalid_enum_error final : public std::logic_error {
@@ -70,30 +74,170 @@ namespace doge {
       {}
    };
 
-   void check_error(std::string const& extra_message = "")
+   /// @brief Thrown at the end of a frame in which the driver reported errors through debug output.
+   ///
+   class debug_output_error final : public std::runtime_error {
+   public:
+      debug_output_error(std::string const& message)
+         : std::runtime_error{"GL debug output: " + message}
+      {}
+   };
+
+   /// @note The message is only copied when an error is thrown, so checking doesn't allocate.
+   ///
+   inline void check_error(std::string_view const extra_message = {})
    {
       switch (const auto error = gl::GetError(); error) {
       case gl::NO_ERROR_:
          return;
       case gl::INVALID_ENUM:
-         throw invalid_enum_error{extra_message};
+         throw invalid_enum_error{std::string{extra_message}};
       case gl::INVALID_VALUE:
-         throw invalid_value_error{extra_message};
+         throw invalid_value_error{std::string{extra_message}};
       case gl::INVALID_OPERATION:
-         throw invalid_operation_error{extra_message};
+         throw invalid_operation_error{std::string{extra_message}};
       case gl::STACK_OVERFLOW:
-         throw stack_overflow_error{extra_message};
+         throw stack_overflow_error{std::string{extra_message}};
       case gl::STACK_UNDERFLOW:
-         throw stack_underflow_error{extra_message};
+         throw stack_underflow_error{std::string{extra_message}};
       case gl::OUT_OF_MEMORY:
-         throw out_of_memory_error{extra_message};
+         throw out_of_memory_error{std::string{extra_message}};
       case gl::INVALID_FRAMEBUFFER_OPERATION:
-         throw invalid_framebuffer_operation_error{extra_message};
+         throw invalid_framebuffer_operation_error{std::string{extra_message}};
       default:
          std::cerr << "Unknown error " << error << ". The program will now terminate.\n";
          std::terminate();
       }
    }
+
+   /// @brief Determines when doge looks for GL errors.
+   ///
+   enum class error_policy {
+      /// @brief Never looks.
+      ignore,
+
+      /// @brief Checks glGetError once, at the end of each frame. This finds errors without
+      ///    stalling the pipeline, but can't say which call caused them.
+      per_frame,
+
+      /// @brief Checks glGetError after every call that doge makes. Each check forces the driver to
+      ///    synchronise, so this is only worth using when debug output isn't available.
+      per_call,
+
+      /// @brief Has the driver report errors through KHR_debug as it finds them. Reports are
+      ///    collected, and thrown at the end of the frame with the driver's description of the
+      ///    offending call.
+      debug_output
+   };
+
+   // Define DOGE_GL_ERROR_POLICY as one of error_policy's enumerators to change the default.
+#ifndef DOGE_GL_ERROR_POLICY
+#ifdef NDEBUG
+#define DOGE_GL_ERROR_POLICY per_frame
+#else
+#define DOGE_GL_ERROR_POLICY debug_output
+#endif // NDEBUG
+#endif // DOGE_GL_ERROR_POLICY
+
+   inline constexpr auto default_error_policy = error_policy::DOGE_GL_ERROR_POLICY;
+
+   /// @brief Applies the error policy to the current context.
+   ///
+   class error_checking {
+   public:
+      /// @brief Changes the policy. This must be called with a current context, and debug_output
+      ///    falls back to per_frame if the context can't provide debug output.
+      ///
+      static void policy(error_policy const p)
+      {
+         policy_ = p;
+         if (policy_ == error_policy::debug_output && gl::DebugMessageCallback != nullptr) {
+            gl::Enable(gl::DEBUG_OUTPUT);
+            gl::DebugMessageCallback(collect, nullptr);
+            gl::DebugMessageControl(gl::DONT_CARE, gl::DONT_CARE, gl::DONT_CARE, 0, nullptr,
+               gl::FALSE_);
+            gl::DebugMessageControl(gl::DONT_CARE, gl::DEBUG_TYPE_ERROR, gl::DONT_CARE, 0, nullptr,
+               gl::TRUE_);
+            return;
+         }
+
+         if (gl::DebugMessageCallback != nullptr) {
+            gl::Disable(gl::DEBUG_OUTPUT);
+            gl::DebugMessageCallback(nullptr, nullptr);
+         }
+
+         if (policy_ == error_policy::debug_output)
+            policy_ = error_policy::per_frame;
+      }
+
+      [[nodiscard]] static error_policy policy() noexcept
+      {
+         return policy_;
+      }
+
+      /// @brief Called by doge's wrappers after each call. Only does anything under per_call.
+      ///
+      static void check_call(std::string_view const what)
+      {
+         if (policy_ == error_policy::per_call)
+            check_error(what);
+      }
+
+      /// @brief Called by engine once each frame has been drawn.
+      /// @throws debug_output_error if the driver has reported any errors since the last frame.
+      ///
+      static void check_frame()
+      {
+         switch (policy_) {
+         case error_policy::per_frame:
+            check_error("end of frame");
+            return;
+         case error_policy::debug_output:
+            if (auto messages = take_reports(); not messages.empty())
+               throw debug_output_error{messages};
+            return;
+         default:
+            return;
+         }
+      }
+   private:
+      static constexpr std::size_t max_reports = 16;
+
+      static inline error_policy policy_ = default_error_policy;
+      static inline std::mutex mutex_;
+      static inline std::vector<std::string> reports_;
+      static inline std::size_t dropped_ = 0;
+
+      // Debug output isn't synchronous, so the driver may call this from any of its threads.
+      static void APIENTRY collect(GLenum, GLenum, GLuint const id, GLenum, GLsizei const length,
+         GLchar const* const message, void const*)
+      {
+         auto const lock = std::lock_guard{mutex_};
+         if (reports_.size() == max_reports) {
+            ++dropped_;
+            return;
+         }
+
+         reports_.push_back("[" + std::to_string(id) + "] "
+            + (length < 0 ? std::string{message}
+                          : std::string{message, static_cast<std::size_t>(length)}));
+      }
+
+      static std::string take_reports()
+      {
+         auto const lock = std::lock_guard{mutex_};
+         auto result = std::string{};
+         for (auto const& report : reports_)
+            result += (result.empty() ? "" : "\n") + report;
+
+         if (dropped_ != 0)
+            result += "\n(and " + std::to_string(dropped_) + " more)";
+
+         reports_.clear();
+         dropped_ = 0;
+         return result;
+      }
+   };
 } // namespace doge
 
 #endif // DOGE_GL_GL_ERROR_HPP
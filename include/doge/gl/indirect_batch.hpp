@@ -0,0 +1,242 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_INDIRECT_BATCH_HPP
+#define DOGE_GL_INDIRECT_BATCH_HPP
+
+#include "doge/gl/buffer.hpp"
+#include "doge/gl/memory.hpp"
+#include "doge/gl/render_queue.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/gl/uniform_uploads.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/functional>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief The layout that glMultiDrawArraysIndirect reads each draw from.
+   ///
+   struct draw_arrays_indirect_command {
+      GLuint count = 0;
+      GLuint instance_count = 0;
+      GLuint first = 0;
+      GLuint base_instance = 0;
+   };
+
+   /// @brief The layout that glMultiDrawElementsIndirect reads each draw from.
+   ///
+   struct draw_elements_indirect_command {
+      GLuint count = 0;
+      GLuint instance_count = 0;
+      GLuint first_index = 0;
+      GLint base_vertex = 0;
+      GLuint base_instance = 0;
+   };
+
+   /// @brief Turns a render_queue into as few draws as possible: consecutive draws that share a
+   ///    program, vertex array, textures, mode, and index type are recorded as commands in an
+   ///    indirect buffer, and issued with one glMultiDrawElementsIndirect or
+   ///    glMultiDrawArraysIndirect.
+   ///
+   /// Uniforms can't change between the draws in a multi-draw, so per-draw data is looked up by
+   /// slot instead. Each draw is given consecutive slots, one per instance, and its command's base
+   /// instance is its first slot. Attributes with a divisor of one start reading at the base
+   /// instance, so an instance_buffer that holds each slot's data, such as a model matrix, feeds
+   /// every draw in the batch:
+   ///
+   ///    batch.record(queue, [&](doge::draw_call const& draw, GLuint const slot) {
+   ///       transforms[slot] = world[draw.user]; });
+   ///    models.write(transforms);
+   ///    batch.flush();
+   ///
+   /// This is what gl_DrawID is for in GL 4.6 and ARB_shader_draw_parameters, neither of which
+   /// doge requires.
+   ///
+   class indirect_batch {
+   public:
+      /// @brief Sorts queue, records its draws, and then empties it.
+      /// @param per_draw Invoked with each draw and its first slot, in the order that the draws
+      ///    will be issued.
+      ///
+      template <ranges::Invocable<draw_call const&, GLuint> F>
+      void record(render_queue& queue, F const& per_draw)
+      {
+         queue.sort();
+         queue.for_each([this, &per_draw](draw_key, draw_call const& draw) {
+            ranges::invoke(per_draw, draw, slots_);
+            record(draw);
+         });
+         queue.clear();
+      }
+
+      void record(render_queue& queue)
+      {
+         record(queue, [](draw_call const&, GLuint) {});
+      }
+
+      /// @brief Uploads the recorded commands, issues one multi-draw per bucket of draws that share
+      ///    state, and then forgets the commands.
+      /// @param per_bucket Invoked with the first draw of each bucket after its state has been
+      ///    bound, and immediately before the bucket is issued.
+      ///
+      template <ranges::Invocable<draw_call const&> F>
+      void flush(F const& per_bucket)
+      {
+         if (ranges::empty(buckets_))
+            return;
+
+         upload();
+         auto const elements_offset = ranges::size(arrays_) * sizeof(draw_arrays_indirect_command);
+         for (auto const& b : buckets_) {
+            b.state.bind();
+            ranges::invoke(per_bucket, b.state);
+            uniform_uploads::flush(b.state.program);
+            if (b.state.index_type == gl::NONE) {
+               gl::MultiDrawArraysIndirect(b.state.mode, reinterpret_cast<void const*>(
+                  b.first * sizeof(draw_arrays_indirect_command)), b.count, 0);
+            }
+            else {
+               gl::MultiDrawElementsIndirect(b.state.mode, b.state.index_type,
+                  reinterpret_cast<void const*>(elements_offset
+                     + b.first * sizeof(draw_elements_indirect_command)), b.count, 0);
+            }
+         }
+
+         clear();
+      }
+
+      void flush()
+      {
+         flush([](draw_call const&) {});
+      }
+
+      void clear() noexcept
+      {
+         buckets_.clear();
+         arrays_.clear();
+         elements_.clear();
+         slots_ = 0;
+      }
+
+      /// @brief The number of draws that have been recorded.
+      ///
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return ranges::size(arrays_) + ranges::size(elements_);
+      }
+
+      /// @brief The number of multi-draws that flush() will issue.
+      ///
+      [[nodiscard]] std::size_t buckets() const noexcept
+      {
+         return ranges::size(buckets_);
+      }
+
+      /// @brief The number of slots that the recorded draws use, which is how many entries the
+      ///    per-draw data needs.
+      ///
+      [[nodiscard]] GLuint slots() const noexcept
+      {
+         return slots_;
+      }
+   private:
+      // A run of commands that are issued together. state is the run's first draw.
+      struct bucket {
+         draw_call state;
+         std::size_t first;
+         GLsizei count;
+      };
+
+      std::vector<bucket> buckets_;
+      std::vector<draw_arrays_indirect_command> arrays_;
+      std::vector<draw_elements_indirect_command> elements_;
+      GLuint slots_ = 0;
+      gpu_ptr<resource_type::buffer> buffer_;
+      std::size_t capacity_ = 0;
+
+      void record(draw_call const& draw)
+      {
+         Expects(draw.instances > 0);
+         auto const instances = gsl::narrow_cast<GLuint>(draw.instances);
+         auto const indexed = draw.index_type != gl::NONE;
+         auto const first = indexed ? ranges::size(elements_) : ranges::size(arrays_);
+         if (indexed) {
+            auto const index_size = detail::index_size(draw.index_type);
+            Expects(draw.first % index_size == 0);
+            elements_.push_back({gsl::narrow_cast<GLuint>(draw.count), instances,
+               gsl::narrow_cast<GLuint>(draw.first / index_size), draw.base_vertex, slots_});
+         }
+         else {
+            arrays_.push_back({gsl::narrow_cast<GLuint>(draw.count), instances,
+               gsl::narrow_cast<GLuint>(draw.first), slots_});
+         }
+
+         slots_ += instances;
+         if (not ranges::empty(buckets_) && same_state(buckets_.back().state, draw)
+            && buckets_.back().first + gsl::narrow_cast<std::size_t>(buckets_.back().count) == first) {
+            ++buckets_.back().count;
+            return;
+         }
+
+         buckets_.push_back({draw, first, 1});
+      }
+
+      // The array commands come first, followed by the element commands. The buffer has to be
+      // bound to gl::DRAW_INDIRECT_BUFFER to be drawn from, so it's filled through that binding,
+      // and orphaned each time so that a frame in flight isn't waited on.
+      void upload() noexcept
+      {
+         auto const arrays = ranges::size(arrays_) * sizeof(draw_arrays_indirect_command);
+         auto const elements = ranges::size(elements_) * sizeof(draw_elements_indirect_command);
+         auto const bytes = arrays + elements;
+         if (bytes > capacity_)
+            capacity_ = std::max(bytes, 2 * capacity_);
+
+         state_cache::bind_buffer(gl::DRAW_INDIRECT_BUFFER, *buffer_);
+         gl::BufferData(gl::DRAW_INDIRECT_BUFFER, gsl::narrow_cast<GLsizeiptr>(capacity_), nullptr,
+            gl::STREAM_DRAW);
+         gl::BufferSubData(gl::DRAW_INDIRECT_BUFFER, 0, gsl::narrow_cast<GLsizeiptr>(arrays),
+            ranges::data(arrays_));
+         gl::BufferSubData(gl::DRAW_INDIRECT_BUFFER, gsl::narrow_cast<GLintptr>(arrays),
+            gsl::narrow_cast<GLsizeiptr>(elements), ranges::data(elements_));
+      }
+
+      static bool same_state(draw_call const& a, draw_call const& b) noexcept
+      {
+         if (a.program != b.program || a.vertex_array != b.vertex_array || a.mode != b.mode
+            || a.index_type != b.index_type) {
+            return false;
+         }
+
+         for (auto i = std::size_t{0}; i < ranges::size(a.textures); ++i) {
+            if (a.textures[i].target != b.textures[i].target
+               || a.textures[i].texture != b.textures[i].texture) {
+               return false;
+            }
+         }
+
+         return true;
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_GL_INDIRECT_BATCH_HPP
@@ -2,27 +2,181 @@
 #define DOGE_GL_MEMORY_HPP
 
 #include <array>
+#include <cstddef>
+#include <experimental/ranges/algorithm>
 #include <experimental/ranges/concepts>
-#include <experimental/ranges/functional>
-#include <functional>
+#include <experimental/ranges/iterator>
+#include <gsl/gsl>
+#include <doge/gl/direct_state_access.hpp>
+#include <doge/gl/state_cache.hpp>
 #include "gl/gl_core.hpp"
-
-#pragma GCC diagnostic push 
-#pragma GCC diagnostic ignored "-Wsign-compare"
-#include "unique_resource.h"
-#pragma GCC diagnostic pop
+#include <utility>
+#include <vector>
 
 namespace doge {
    namespace ranges = std::experimental::ranges;
-   enum class resource_type { buffer, framebuffer, vertex_array };
+   enum class resource_type { buffer, framebuffer, query, vertex_array };
+
+   /// @brief Makes GL object names in batches, and deletes them in batches, so that creating and
+   ///    destroying a transient object costs a share of a driver call rather than a whole one.
+   ///
+   /// Released names aren't handed straight back out. A GL object keeps its state until it's
+   /// deleted (a buffer's immutable storage can't even be replaced), so a recycled object would be
+   /// indistinguishable from a broken one. Released names are deleted together instead, which
+   /// returns them to the driver for the next batch to reuse.
+   ///
+   /// When direct state access is supported, names are made with glCreate*, so they're objects
+   /// whether or not direct state access is enabled at the time.
+   ///
+   template <resource_type T>
+   class name_pool {
+   public:
+      static constexpr std::size_t batch_size = 32;
+
+      /// @brief Fills names with fresh names, making another batch if the pool has run out.
+      ///
+      static void acquire(gsl::span<GLuint> const names)
+      {
+         if (released_.capacity() < batch_size)
+            released_.reserve(batch_size);
+
+         for (auto& name : names) {
+            if (ranges::empty(available_)) {
+               available_.resize(batch_size);
+               make(gsl::narrow_cast<GLsizei>(batch_size), ranges::data(available_));
+            }
+
+            name = available_.back();
+            available_.pop_back();
+         }
+      }
+
+      /// @brief Queues names for deletion. The queue is deleted once it holds a batch.
+      /// @note The objects stay alive until then, so collect() should be called after releasing
+      ///    something large.
+      ///
+      static void release(gsl::span<GLuint const> const names) noexcept
+      {
+         for (auto const name : names) {
+            // Every name was acquired first, which reserved a batch's worth of room.
+            released_.push_back(name);
+            if (ranges::size(released_) == batch_size)
+               collect();
+         }
+      }
+
+      /// @brief Deletes every name that's been released.
+      ///
+      static void collect() noexcept
+      {
+         if (ranges::empty(released_))
+            return;
+
+         destroy(gsl::narrow_cast<GLsizei>(ranges::size(released_)), ranges::data(released_));
+         if constexpr (T == resource_type::buffer)
+            state_cache::deleted_buffers(released_);
+         else if constexpr (T == resource_type::vertex_array)
+            state_cache::deleted_vertex_arrays(released_);
+         released_.clear();
+      }
+
+      /// @brief Forgets every pooled name without deleting it, for when the context that owns the
+      ///    names has been destroyed.
+      ///
+      static void clear() noexcept
+      {
+         available_.clear();
+         released_.clear();
+      }
+
+      /// @brief The number of names that have been made, but not handed out.
+      ///
+      [[nodiscard]] static std::size_t available() noexcept
+      {
+         return ranges::size(available_);
+      }
+
+      /// @brief The number of names that are waiting to be deleted.
+      ///
+      [[nodiscard]] static std::size_t released() noexcept
+      {
+         return ranges::size(released_);
+      }
+   private:
+      static inline std::vector<GLuint> available_;
+      static inline std::vector<GLuint> released_;
+
+      // glCreateQueries needs to know each query's target, so queries are always generated.
+      static void make(GLsizei const n, GLuint* const names) noexcept
+      {
+         auto const create = direct_state_access::supported();
+         if constexpr (T == resource_type::buffer)
+            (create ? gl::CreateBuffers : gl::GenBuffers)(n, names);
+         else if constexpr (T == resource_type::framebuffer)
+            (create ? gl::CreateFramebuffers : gl::GenFramebuffers)(n, names);
+         else if constexpr (T == resource_type::query)
+            gl::GenQueries(n, names);
+         else if constexpr (T == resource_type::vertex_array)
+            (create ? gl::CreateVertexArrays : gl::GenVertexArrays)(n, names);
+      }
+
+      static void destroy(GLsizei const n, GLuint const* const names) noexcept
+      {
+         if constexpr (T == resource_type::buffer)
+            gl::DeleteBuffers(n, names);
+         else if constexpr (T == resource_type::framebuffer)
+            gl::DeleteFramebuffers(n, names);
+         else if constexpr (T == resource_type::query)
+            gl::DeleteQueries(n, names);
+         else if constexpr (T == resource_type::vertex_array)
+            gl::DeleteVertexArrays(n, names);
+      }
+   };
+
+   /// @brief Empties every name_pool, for when a new context replaces the one that made the names.
+   ///
+   inline void forget_pooled_names() noexcept
+   {
+      name_pool<resource_type::buffer>::clear();
+      name_pool<resource_type::framebuffer>::clear();
+      name_pool<resource_type::query>::clear();
+      name_pool<resource_type::vertex_array>::clear();
+   }
 
+   /// @brief Owns N names of type T, which are taken from, and given back to, name_pool<T>.
+   ///
+   /// A gpu_ptr is just its names: moving it copies them, and a moved-from gpu_ptr holds zeroes,
+   /// which it doesn't release.
+   ///
    template <resource_type T, int N = 1>
    requires
       N > 0
    class gpu_ptr {
-      using unique_resource = std::experimental::unique_resource<std::array<GLuint, N>,
-         std::function<void(std::array<GLuint, N> const&)>>;
    public:
+      gpu_ptr()
+      {
+         name_pool<T>::acquire(names_);
+      }
+
+      gpu_ptr(gpu_ptr&& other) noexcept
+         : names_{std::exchange(other.names_, {})}
+      {}
+
+      gpu_ptr& operator=(gpu_ptr&& other) noexcept
+      {
+         if (this != &other) {
+            reset();
+            names_ = std::exchange(other.names_, {});
+         }
+
+         return *this;
+      }
+
+      ~gpu_ptr()
+      {
+         reset();
+      }
+
       GLuint operator[](int const i) const noexcept
       requires
          N > 1
@@ -39,41 +193,17 @@ namespace doge {
          return get()[0];
       }
 
-      auto const& get() const noexcept
+      std::array<GLuint, N> const& get() const noexcept
       {
-         return resource_.get();
+         return names_;
       }
    private:
-      unique_resource resource_ = []{
-         auto const [allocator, deleter] = gpu_ptr_allocator();
-         ranges::Regular result = std::array<GLuint, N>{};
-         allocator(ranges::size(result), ranges::data(result));
-
-         return unique_resource(std::move(result),
-            [deleter](ranges::RandomAccessRange const& resource) noexcept {
-               deleter(ranges::size(resource), ranges::data(resource));
-         });
-      }();
-
-      static auto gpu_ptr_allocator() noexcept
-      requires
-         T == resource_type::buffer
-      {
-         return std::make_pair(gl::GenBuffers, gl::DeleteBuffers);
-      }
-
-      static auto gpu_ptr_allocator() noexcept
-      requires
-         T == resource_type::framebuffer
-      {
-         return std::make_pair(gl::GenFramebuffers, gl::DeleteFramebuffers);
-      }
+      std::array<GLuint, N> names_ = {};
 
-      static auto gpu_ptr_allocator() noexcept
-      requires
-         T == resource_type::vertex_array
+      void reset() noexcept
       {
-         return std::make_pair(gl::GenVertexArrays, gl::DeleteVertexArrays);
+         if (names_[0] != 0)
+            name_pool<T>::release(names_);
       }
    };
 } // namespace doge
@@ -0,0 +1,305 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_MESH_HEAP_HPP
+#define DOGE_GL_MESH_HEAP_HPP
+
+#include "doge/gl/direct_state_access.hpp"
+#include "doge/gl/memory.hpp"
+#include "doge/gl/render_queue.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/gl/uniform_uploads.hpp"
+#include "doge/gl/vertex_array.hpp"
+#include "doge/utility/std_layout_tuple.hpp"
+#include "doge/utility/tlsf_allocator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <experimental/ranges/concepts>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <utility>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief Where a mesh lives in a mesh_heap.
+   ///
+   struct heap_mesh {
+      tlsf_allocator::allocation vertices;
+      tlsf_allocator::allocation elements;
+
+      /// @brief The index of the mesh's first vertex in the heap's vertex buffer, which is added to
+      ///    each of the mesh's indices.
+      GLint base_vertex = 0;
+
+      /// @brief The number of indices, or the number of vertices if the mesh isn't indexed.
+      GLsizei count = 0;
+
+      /// @brief The byte offset of the mesh's first index in the heap's element buffer.
+      GLintptr first_index = 0;
+
+      [[nodiscard]] bool indexed() const noexcept
+      {
+         return elements.size != 0;
+      }
+   };
+
+   /// @brief Packs many meshes with the same vertex format into one vertex buffer and one element
+   ///    buffer, which share a single vertex array.
+   ///
+   /// Vertices are aligned to their own size, so each mesh is addressed by a base vertex, and its
+   /// indices stay relative to its own vertices. Every mesh is drawn without rebinding anything,
+   /// which is what batching draws by base vertex relies on. Space is handed out by a
+   /// tlsf_allocator, and a buffer that runs out of space is reallocated at least twice as big, with
+   /// its contents copied on the GPU, so existing heap_meshes stay valid.
+   ///
+   ///    auto heap = doge::mesh_heap<doge::vec3, doge::vec3, doge::vec2>{1 << 16, 1 << 18};
+   ///    auto const cube = heap.allocate(cube_vertices, cube_elements);
+   ///    queue.submit(heap.as_draw_call(cube), 0, depth);
+   ///
+   template <typename... Ts>
+   requires
+      (StandardLayout<Ts> && ...) &&
+      ((detail::attribute_traits<Ts>::components <= 4) && ...)
+   class mesh_heap {
+   public:
+      using vertex_type = std_layout_tuple<Ts...>;
+
+      /// @param vertices The number of vertices that the heap starts with room for.
+      /// @param elements The number of indices that the heap starts with room for.
+      ///
+      mesh_heap(std::size_t const vertices, std::size_t const elements)
+         : vertices_{vertices * sizeof(vertex_type)},
+           elements_{elements * sizeof(GLuint)}
+      {
+         detail::vertex_format<Ts...>::attach(*vao_, *vertices_.buffer);
+         attach_elements();
+      }
+
+      /// @brief Copies a mesh into the heap, growing the heap if it's full.
+      /// @param elements Indices into vertices. May be empty, in which case the mesh is drawn with
+      ///    glDrawArrays.
+      ///
+      [[nodiscard]] heap_mesh allocate(gsl::span<vertex_type const> const vertices,
+         gsl::span<GLuint const> const elements = {})
+      {
+         Expects(not ranges::empty(vertices));
+
+         auto result = heap_mesh{};
+         result.vertices = vertices_.allocate(ranges::size(vertices) * sizeof(vertex_type),
+            sizeof(vertex_type), ranges::data(vertices));
+         result.base_vertex = gsl::narrow_cast<GLint>(result.vertices.offset / sizeof(vertex_type));
+
+         if (ranges::empty(elements)) {
+            result.count = gsl::narrow_cast<GLsizei>(ranges::size(vertices));
+         }
+         else {
+            result.elements = elements_.allocate(ranges::size(elements) * sizeof(GLuint),
+               sizeof(GLuint), ranges::data(elements));
+            result.count = gsl::narrow_cast<GLsizei>(ranges::size(elements));
+            result.first_index = gsl::narrow_cast<GLintptr>(result.elements.offset);
+         }
+
+         // Growing a buffer replaces it, so the vertex array needs to be pointed at the new one.
+         if (std::exchange(vertices_.grown, false))
+            detail::vertex_format<Ts...>::attach(*vao_, *vertices_.buffer);
+         if (std::exchange(elements_.grown, false))
+            attach_elements();
+
+         return result;
+      }
+
+      /// @brief Returns a mesh's space to the heap. Its contents are left as they are.
+      ///
+      void deallocate(heap_mesh const& mesh) noexcept
+      {
+         vertices_.allocator.deallocate(mesh.vertices);
+         if (mesh.indexed())
+            elements_.allocator.deallocate(mesh.elements);
+      }
+
+      /// @brief Sources per-instance attributes, which every mesh in the heap shares, from
+      ///    instances.
+      /// @see vertex_array_buffer::attach
+      ///
+      template <basic_buffer_usage InstanceUsage, typename... Is>
+      void attach(instance_buffer<InstanceUsage, Is...> const& instances) noexcept
+      {
+         detail::vertex_format<Is...>::attach(*vao_, instances.get(),
+            detail::vertex_format<Ts...>::locations, 1, detail::instance_binding);
+      }
+
+      template <ranges::Invocable F>
+      void bind(F const& f) const noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      {
+         state_cache::bind_vertex_array(*vao_);
+         ranges::invoke(f);
+      }
+
+      template <ranges::Invocable F>
+      void draw(heap_mesh const& mesh, F const& f) const
+         noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      {
+         bind([&mesh, f]{
+            ranges::invoke(f);
+            uniform_uploads::flush();
+            if (mesh.indexed()) {
+               gl::DrawElementsBaseVertex(gl::TRIANGLES, mesh.count, gl::UNSIGNED_INT,
+                  reinterpret_cast<void const*>(mesh.first_index), mesh.base_vertex);
+            }
+            else {
+               gl::DrawArrays(gl::TRIANGLES, mesh.base_vertex, mesh.count);
+            }
+         });
+      }
+
+      /// @brief Describes what draw(mesh, f) issues, so that it can be submitted to a render_queue.
+      ///
+      [[nodiscard]] draw_call as_draw_call(heap_mesh const& mesh) const noexcept
+      {
+         auto result = draw_call{};
+         result.vertex_array = *vao_;
+         result.count = mesh.count;
+         if (mesh.indexed()) {
+            result.index_type = gl::UNSIGNED_INT;
+            result.first = mesh.first_index;
+            result.base_vertex = mesh.base_vertex;
+         }
+         else {
+            result.first = mesh.base_vertex;
+         }
+
+         return result;
+      }
+
+      [[nodiscard]] GLuint vertex_array() const noexcept
+      {
+         return *vao_;
+      }
+
+      [[nodiscard]] GLuint vertex_buffer() const noexcept
+      {
+         return *vertices_.buffer;
+      }
+
+      [[nodiscard]] GLuint element_buffer() const noexcept
+      {
+         return *elements_.buffer;
+      }
+
+      /// @brief The number of vertices that the heap has room for.
+      ///
+      [[nodiscard]] std::size_t vertex_capacity() const noexcept
+      {
+         return vertices_.allocator.capacity() / sizeof(vertex_type);
+      }
+
+      /// @brief The number of indices that the heap has room for.
+      ///
+      [[nodiscard]] std::size_t element_capacity() const noexcept
+      {
+         return elements_.allocator.capacity() / sizeof(GLuint);
+      }
+   private:
+      // A buffer and the bookkeeping for its bytes.
+      struct heap {
+         gpu_ptr<resource_type::buffer> buffer;
+         tlsf_allocator allocator;
+         bool grown = false;
+
+         explicit heap(std::size_t const bytes)
+            : allocator{bytes}
+         {
+            storage(*buffer, bytes);
+         }
+
+         tlsf_allocator::allocation allocate(std::size_t const bytes, std::size_t const alignment,
+            void const* const data)
+         {
+            auto result = allocator.allocate(bytes, alignment);
+            if (not result) {
+               // Enough room at the end for bytes, wherever the alignment falls.
+               grow(std::max(2 * allocator.capacity(), allocator.capacity() + bytes + alignment));
+               result = allocator.allocate(bytes, alignment);
+               Ensures(result);
+            }
+
+            if (direct_state_access::enabled()) {
+               gl::NamedBufferSubData(*buffer, gsl::narrow_cast<GLintptr>(result->offset),
+                  gsl::narrow_cast<GLsizeiptr>(bytes), data);
+            }
+            else {
+               state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *buffer);
+               gl::BufferSubData(gl::COPY_WRITE_BUFFER, gsl::narrow_cast<GLintptr>(result->offset),
+                  gsl::narrow_cast<GLsizeiptr>(bytes), data);
+            }
+
+            return *result;
+         }
+
+         void grow(std::size_t const bytes)
+         {
+            auto replacement = gpu_ptr<resource_type::buffer>{};
+            storage(*replacement, bytes);
+
+            auto const used = gsl::narrow_cast<GLsizeiptr>(allocator.capacity());
+            if (used > 0 && direct_state_access::enabled()) {
+               gl::CopyNamedBufferSubData(*buffer, *replacement, 0, 0, used);
+            }
+            else if (used > 0) {
+               state_cache::bind_buffer(gl::COPY_READ_BUFFER, *buffer);
+               state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *replacement);
+               gl::CopyBufferSubData(gl::COPY_READ_BUFFER, gl::COPY_WRITE_BUFFER, 0, 0, used);
+            }
+
+            // The old buffer is as large as everything in the heap, so it's deleted now rather than
+            // left waiting in the pool for a batch to fill.
+            buffer = std::move(replacement);
+            name_pool<resource_type::buffer>::collect();
+            allocator.grow(bytes);
+            grown = true;
+         }
+
+         static void storage(GLuint const buffer, std::size_t const bytes) noexcept
+         {
+            auto const size = gsl::narrow_cast<GLsizeiptr>(bytes);
+            if (direct_state_access::enabled()) {
+               gl::NamedBufferData(buffer, size, nullptr, gl::STATIC_DRAW);
+               return;
+            }
+
+            state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, buffer);
+            gl::BufferData(gl::COPY_WRITE_BUFFER, size, nullptr, gl::STATIC_DRAW);
+         }
+      };
+
+      gpu_ptr<resource_type::vertex_array> vao_;
+      heap vertices_;
+      heap elements_;
+
+      void attach_elements() noexcept
+      {
+         if (direct_state_access::enabled()) {
+            gl::VertexArrayElementBuffer(*vao_, *elements_.buffer);
+            return;
+         }
+
+         state_cache::bind_vertex_array(*vao_);
+         state_cache::bind_buffer(gl::ELEMENT_ARRAY_BUFFER, *elements_.buffer);
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_GL_MESH_HEAP_HPP
@@ -0,0 +1,205 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_PACKED_ATTRIBUTES_HPP
+#define DOGE_GL_PACKED_ATTRIBUTES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <experimental/ranges/iterator>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <gsl/gsl>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief An IEEE 754 half-precision float, which vertex attributes can be stored as when they
+   ///    don't need 32 bits, such as positions in a small model, or texture coordinates.
+   ///
+   /// Converting from a float rounds to the nearest half, ties to even. Floats that are too big
+   /// become infinity, and NaNs stay NaNs.
+   ///
+   struct half {
+      std::uint16_t bits = 0;
+
+      half() = default;
+
+      explicit half(float const f) noexcept
+         : bits{from_float(f)}
+      {}
+
+      explicit operator float() const noexcept
+      {
+         return to_float(bits);
+      }
+
+      static std::uint16_t from_float(float const f) noexcept
+      {
+         constexpr auto infinity = std::uint32_t{255} << 23;
+         constexpr auto too_big = std::uint32_t{127 + 16} << 23;
+         constexpr auto smallest_normal = std::uint32_t{127 - 14} << 23;
+         constexpr auto denormal_magic = std::uint32_t{(127 - 15) + (23 - 10) + 1} << 23;
+
+         auto u = std::uint32_t{};
+         std::memcpy(&u, &f, sizeof(u));
+         auto const sign = (u >> 16) & 0x8000u;
+         u &= 0x7fff'ffffu;
+
+         auto result = std::uint32_t{};
+         if (u >= too_big) {
+            result = u > infinity ? 0x7e00u : 0x7c00u;
+         }
+         else if (u < smallest_normal) {
+            // Adding the magic number lets the FPU round the mantissa into a denormal.
+            auto magic = float{};
+            std::memcpy(&magic, &denormal_magic, sizeof(magic));
+            auto shifted = float{};
+            std::memcpy(&shifted, &u, sizeof(shifted));
+            shifted += magic;
+            std::memcpy(&result, &shifted, sizeof(result));
+            result -= denormal_magic;
+         }
+         else {
+            // Rebias the exponent from 127 to 15, and round the mantissa to ten bits.
+            auto const odd = (u >> 13) & 1u;
+            u -= std::uint32_t{127 - 15} << 23;
+            u += 0xfffu + odd;
+            result = u >> 13;
+         }
+
+         return gsl::narrow_cast<std::uint16_t>(result | sign);
+      }
+
+      static float to_float(std::uint16_t const h) noexcept
+      {
+         constexpr auto exponent_mask = std::uint32_t{0x7c00} << 13;
+         auto u = (std::uint32_t{h} & 0x7fffu) << 13;
+         auto const exponent = u & exponent_mask;
+         u += std::uint32_t{127 - 15} << 23;
+
+         auto result = float{};
+         if (exponent == exponent_mask) {
+            u += std::uint32_t{128 - 16} << 23;
+         }
+         else if (exponent == 0) {
+            // A denormal, which the FPU renormalises.
+            constexpr auto magic = std::uint32_t{113} << 23;
+            u += 1u << 23;
+            auto f = float{};
+            std::memcpy(&f, &u, sizeof(f));
+            auto m = float{};
+            std::memcpy(&m, &magic, sizeof(m));
+            f -= m;
+            std::memcpy(&u, &f, sizeof(u));
+         }
+
+         u |= (std::uint32_t{h} & 0x8000u) << 16;
+         std::memcpy(&result, &u, sizeof(result));
+         return result;
+      }
+   };
+
+   /// @brief Converts every float in in to a half. The loop has no calls or early exits, so that
+   ///    the compiler can vectorise it.
+   /// @note in and out must have the same size.
+   ///
+   inline void to_halves(gsl::span<float const> const in, gsl::span<half> const out) noexcept
+   {
+      Expects(ranges::size(in) == ranges::size(out));
+      auto const* const source = ranges::data(in);
+      auto* const destination = ranges::data(out);
+      for (auto i = std::ptrdiff_t{0}; i < ranges::size(in); ++i)
+         destination[i].bits = half::from_float(source[i]);
+   }
+
+   /// @brief L halves, which the vertex shader reads as a vecL.
+   /// @note Attributes are fetched fastest when they're aligned to four bytes, so prefer half2 and
+   ///    half4 to half3.
+   ///
+   template <glm::length_t L>
+   struct half_vec {
+      std::array<half, L> value = {};
+
+      half_vec() = default;
+
+      explicit half_vec(glm::vec<L, float> const& v) noexcept
+      {
+         for (auto i = 0; i < L; ++i)
+            value[i] = half{v[i]};
+      }
+   };
+
+   using half2 = half_vec<2>;
+   using half3 = half_vec<3>;
+   using half4 = half_vec<4>;
+
+   /// @brief L unsigned bytes, which the vertex shader reads as a vecL in the range [0, 1]. This is
+   ///    what colours are usually stored as.
+   ///
+   template <glm::length_t L>
+   struct unorm8_vec {
+      std::array<std::uint8_t, L> value = {};
+
+      unorm8_vec() = default;
+
+      /// @param v Each component is clamped to [0, 1].
+      ///
+      explicit unorm8_vec(glm::vec<L, float> const& v) noexcept
+      {
+         for (auto i = 0; i < L; ++i)
+            value[i] = static_cast<std::uint8_t>(std::lround(std::clamp(v[i], 0.0f, 1.0f) * 255.0f));
+      }
+   };
+
+   using unorm8x2 = unorm8_vec<2>;
+   using unorm8x4 = unorm8_vec<4>;
+
+   /// @brief A vec4 packed into 32 bits as GL_INT_2_10_10_10_REV: ten signed bits each for x, y,
+   ///    and z, and two for w. The vertex shader reads it as a vec4 in the range [-1, 1], which is
+   ///    plenty for a unit normal or tangent.
+   ///
+   struct snorm_10_10_10_2 {
+      std::uint32_t bits = 0;
+
+      snorm_10_10_10_2() = default;
+
+      /// @param v Each component is clamped to [-1, 1].
+      ///
+      explicit snorm_10_10_10_2(glm::vec4 const& v) noexcept
+         : bits{field(v.x, 10, 0) | field(v.y, 10, 10) | field(v.z, 10, 20) | field(v.w, 2, 30)}
+      {}
+
+      /// @brief Packs a normal, with a w of zero.
+      ///
+      explicit snorm_10_10_10_2(glm::vec3 const& v) noexcept
+         : snorm_10_10_10_2{glm::vec4{v, 0.0f}}
+      {}
+   private:
+      // The largest value that a signed field of width bits holds represents 1.
+      static std::uint32_t field(float const f, int const bits, int const shift) noexcept
+      {
+         auto const scale = static_cast<float>((1 << (bits - 1)) - 1);
+         auto const value = std::lround(std::clamp(f, -1.0f, 1.0f) * scale);
+         return (static_cast<std::uint32_t>(value) & ((1u << bits) - 1)) << shift;
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_GL_PACKED_ATTRIBUTES_HPP
@@ -0,0 +1,213 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_PROGRAM_REFLECTION_HPP
+#define DOGE_GL_PROGRAM_REFLECTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/ranges/concepts>
+#include <gl/gl_core.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief The name of a uniform, block, or attribute, hashed with 64-bit FNV-1a.
+   ///
+   /// Names that are stored in constexpr variables are hashed at compile time, so looking them up
+   /// does no string work at all:
+   ///
+   ///    constexpr auto view = "view"_name;
+   ///    auto u = doge::uniform(program, view, camera.view());
+   ///
+   class resource_name {
+   public:
+      constexpr resource_name(std::string_view const name) noexcept
+         : hash_{hash(name)},
+           name_{name}
+      {}
+
+      constexpr resource_name(char const* const name) noexcept
+         : resource_name{std::string_view{name}}
+      {}
+
+      resource_name(std::string const& name) noexcept
+         : resource_name{std::string_view{name}}
+      {}
+
+      [[nodiscard]] constexpr std::uint64_t hash() const noexcept
+      {
+         return hash_;
+      }
+
+      /// @brief The unhashed name, for error messages. This is only valid for as long as the string
+      ///    that the resource_name was made from.
+      ///
+      [[nodiscard]] constexpr std::string_view name() const noexcept
+      {
+         return name_;
+      }
+
+      [[nodiscard]] static constexpr std::uint64_t hash(std::string_view const name) noexcept
+      {
+         auto result = std::uint64_t{14695981039346656037u};
+         for (auto const c : name)
+            result = (result ^ static_cast<unsigned char>(c)) * 1099511628211u;
+
+         // Zero marks an empty slot in a reflection table.
+         return result != 0 ? result : 1;
+      }
+   private:
+      std::uint64_t hash_;
+      std::string_view name_;
+   };
+
+   inline namespace name_literals {
+      constexpr resource_name operator""_name(char const* const name,
+         std::size_t const size) noexcept
+      {
+         return resource_name{std::string_view{name, size}};
+      }
+   } // inline namespace name_literals
+
+   /// @brief An active uniform that isn't in a block, or an active vertex attribute.
+   ///
+   struct variable_info {
+      GLint location = -1;
+      GLenum type = gl::NONE;
+      GLint array_size = 1;
+   };
+
+   /// @brief An active uniform block or shader storage block.
+   ///
+   struct block_info {
+      GLuint index = gl::INVALID_INDEX;
+      GLint binding = 0;
+      GLint data_size = 0;
+   };
+
+   namespace detail {
+      /// @brief An open-addressed hash table keyed by resource_name hashes. It's filled once, when a
+      ///    program is linked, and is then only read.
+      ///
+      template <ranges::Semiregular T>
+      class reflection_table {
+      public:
+         /// @returns false if another name with the same hash is already in the table.
+         ///
+         bool insert(std::uint64_t const hash, T const& value)
+         {
+            if (2 * (size_ + 1) > ranges::size(slots_))
+               grow();
+
+            auto& slot = slots_[probe(slots_, hash)];
+            if (slot.first != 0)
+               return false;
+
+            slot = {hash, value};
+            ++size_;
+            return true;
+         }
+
+         [[nodiscard]] T const* find(std::uint64_t const hash) const noexcept
+         {
+            if (size_ == 0)
+               return nullptr;
+
+            auto const& slot = slots_[probe(slots_, hash)];
+            return slot.first == hash ? &slot.second : nullptr;
+         }
+
+         [[nodiscard]] std::size_t size() const noexcept
+         {
+            return size_;
+         }
+      private:
+         using slots = std::vector<std::pair<std::uint64_t, T>>;
+
+         slots slots_;
+         std::size_t size_ = 0;
+
+         // Returns the index of the slot that holds hash, or of the empty slot that it would go in.
+         // The table is never more than half full, so there's always an empty slot.
+         static std::size_t probe(slots const& s, std::uint64_t const hash) noexcept
+         {
+            auto const mask = ranges::size(s) - 1;
+            auto i = static_cast<std::size_t>(hash) & mask;
+            while (s[i].first != hash && s[i].first != 0)
+               i = (i + 1) & mask;
+            return i;
+         }
+
+         void grow()
+         {
+            auto const capacity = std::max<std::size_t>(16, 2 * ranges::size(slots_));
+            auto const old = std::exchange(slots_, slots(capacity));
+            for (auto const& slot : old) {
+               if (slot.first != 0)
+                  slots_[probe(slots_, slot.first)] = slot;
+            }
+         }
+      };
+   } // namespace detail
+
+   /// @brief Everything that a program exposes, gathered once when it's linked.
+   ///
+   class program_reflection {
+   public:
+      program_reflection() = default;
+
+      /// @brief Enumerates program's active resources.
+      /// @throws std::runtime_error if two of the program's names have the same hash.
+      ///
+      explicit program_reflection(GLuint program);
+
+      /// @returns nullptr if there's no active uniform called name outside of a block.
+      /// @note Arrays can be found by their name with or without a subscript, as with
+      ///    glGetUniformLocation.
+      ///
+      [[nodiscard]] variable_info const* uniform(resource_name const name) const noexcept
+      {
+         return uniforms_.find(name.hash());
+      }
+
+      [[nodiscard]] block_info const* uniform_block(resource_name const name) const noexcept
+      {
+         return uniform_blocks_.find(name.hash());
+      }
+
+      [[nodiscard]] block_info const* storage_block(resource_name const name) const noexcept
+      {
+         return storage_blocks_.find(name.hash());
+      }
+
+      [[nodiscard]] variable_info const* attribute(resource_name const name) const noexcept
+      {
+         return attributes_.find(name.hash());
+      }
+   private:
+      detail::reflection_table<variable_info> uniforms_;
+      detail::reflection_table<block_info> uniform_blocks_;
+      detail::reflection_table<block_info> storage_blocks_;
+      detail::reflection_table<variable_info> attributes_;
+   };
+} // namespace doge
+
+#endif // DOGE_GL_PROGRAM_REFLECTION_HPP
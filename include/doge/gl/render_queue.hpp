@@ -0,0 +1,336 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_RENDER_QUEUE_HPP
+#define DOGE_GL_RENDER_QUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <doge/gl/state_cache.hpp>
+#include <doge/gl/uniform_uploads.hpp>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/functional>
+#include <experimental/ranges/iterator>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <utility>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief A 64-bit key that orders draws so that the most expensive state changes happen least.
+   ///
+   /// From the most significant bit, an opaque key holds the pass (4 bits), a zero bit, the program
+   /// (11 bits), the material (16 bits), the vertex array (12 bits), and the depth (20 bits), so
+   /// opaque draws are grouped by state and then drawn front-to-back. A translucent key holds the
+   /// pass, a one bit, and then the inverted depth ahead of the state, so translucent draws come
+   /// after the pass's opaque draws, and are drawn back-to-front.
+   ///
+   /// Names that don't fit in their field are truncated: this only affects how well draws are
+   /// grouped, since the draw_call itself holds the real names.
+   ///
+   class draw_key {
+   public:
+      constexpr draw_key() noexcept = default;
+
+      constexpr explicit draw_key(std::uint64_t const value) noexcept
+         : value_{value}
+      {}
+
+      /// @param pass Draws in a lower pass always precede draws in a higher pass. Must be in the
+      ///    range [0, 16).
+      /// @param depth The normalised distance from the camera, in the range [0, 1].
+      ///
+      static constexpr draw_key opaque(int const pass, GLuint const program,
+         std::uint32_t const material, GLuint const vertex_array, float const depth) noexcept
+      {
+         Expects(0 <= pass && pass < 16);
+         return draw_key{field(pass, 4, 60)
+                       | field(program, 11, 48)
+                       | field(material, 16, 32)
+                       | field(vertex_array, 12, 20)
+                       | quantise(depth)};
+      }
+
+      /// @copydoc opaque
+      ///
+      static constexpr draw_key translucent(int const pass, GLuint const program,
+         std::uint32_t const material, GLuint const vertex_array, float const depth) noexcept
+      {
+         Expects(0 <= pass && pass < 16);
+         return draw_key{field(pass, 4, 60)
+                       | field(1, 1, 59)
+                       | (field(depth_mask, 20, 0) - quantise(depth)) << 39
+                       | field(program, 11, 28)
+                       | field(material, 16, 12)
+                       | field(vertex_array, 12, 0)};
+      }
+
+      [[nodiscard]] constexpr std::uint64_t value() const noexcept
+      {
+         return value_;
+      }
+
+      [[nodiscard]] constexpr int pass() const noexcept
+      {
+         return static_cast<int>(value_ >> 60);
+      }
+
+      [[nodiscard]] constexpr bool is_translucent() const noexcept
+      {
+         return (value_ >> 59) & 1;
+      }
+
+      friend constexpr bool operator==(draw_key const a, draw_key const b) noexcept
+      {
+         return a.value_ == b.value_;
+      }
+
+      friend constexpr bool operator!=(draw_key const a, draw_key const b) noexcept
+      {
+         return not (a == b);
+      }
+
+      friend constexpr bool operator<(draw_key const a, draw_key const b) noexcept
+      {
+         return a.value_ < b.value_;
+      }
+   private:
+      static constexpr std::uint64_t depth_mask = (std::uint64_t{1} << 20) - 1;
+
+      std::uint64_t value_ = 0;
+
+      static constexpr std::uint64_t field(std::uint64_t const value, int const bits,
+         int const shift) noexcept
+      {
+         return (value & ((std::uint64_t{1} << bits) - 1)) << shift;
+      }
+
+      static constexpr std::uint64_t quantise(float const depth) noexcept
+      {
+         auto const clamped = depth < 0.0f ? 0.0f : depth > 1.0f ? 1.0f : depth;
+         return static_cast<std::uint64_t>(clamped * static_cast<float>(depth_mask));
+      }
+   };
+
+   /// @brief A texture that a draw_call binds to a texture unit.
+   ///
+   struct texture_binding {
+      GLenum target = gl::TEXTURE_2D;
+      GLuint texture = 0;
+   };
+
+   /// @brief Everything that's needed to issue a single draw.
+   ///
+   struct draw_call {
+      GLuint program = 0;
+      GLuint vertex_array = 0;
+
+      /// @brief textures[i] is bound to unit gl::TEXTURE0 + i. Units whose texture is zero are left
+      ///    alone.
+      std::array<texture_binding, 4> textures = {};
+
+      GLenum mode = gl::TRIANGLES;
+      GLsizei count = 0;
+
+      /// @brief gl::NONE for glDrawArrays, or the type of the bound element array's indices.
+      GLenum index_type = gl::NONE;
+
+      /// @brief The first vertex, or the byte offset of the first index.
+      GLintptr first = 0;
+
+      /// @brief Added to each index before its vertex is fetched. Only used by indexed draws.
+      GLint base_vertex = 0;
+
+      /// @brief The number of instances to draw. Anything other than one issues an instanced draw.
+      GLsizei instances = 1;
+
+      /// @brief Not interpreted by doge: handed back when the draw is issued, so that the caller can
+      ///    look up per-draw data such as a model matrix.
+      std::uint32_t user = 0;
+
+      /// @brief A 16-bit identifier for the set of textures, which groups draws that share them.
+      ///
+      [[nodiscard]] std::uint32_t material() const noexcept
+      {
+         auto hash = std::uint32_t{2166136261u};
+         for (auto const& t : textures)
+            hash = (hash ^ t.texture) * 16777619u;
+         return (hash >> 16) ^ (hash & 0xffff);
+      }
+
+      /// @brief Makes the draw's program, vertex array, and textures current.
+      ///
+      void bind() const noexcept
+      {
+         state_cache::use_program(program);
+         state_cache::bind_vertex_array(vertex_array);
+         for (auto unit = std::size_t{0}; unit < ranges::size(textures); ++unit) {
+            if (auto const& t = textures[unit]; t.texture != 0) {
+               state_cache::bind_texture_unit(gl::TEXTURE0 + gsl::narrow_cast<GLenum>(unit),
+                  t.target, t.texture);
+            }
+         }
+      }
+   };
+
+   /// @brief Collects draws, sorts them by key, and then issues them in that order.
+   ///
+   class render_queue {
+   public:
+      void submit(draw_key const key, draw_call const& draw)
+      {
+         entries_.push_back({key.value(), gsl::narrow_cast<std::uint32_t>(ranges::size(draws_))});
+         draws_.push_back(draw);
+      }
+
+      /// @brief Submits draw with a key built from its own program, textures, and vertex array.
+      /// @param depth The normalised distance from the camera, in the range [0, 1].
+      ///
+      void submit(draw_call const& draw, int const pass, float const depth,
+         bool const translucent = false)
+      {
+         auto const key = translucent
+                        ? draw_key::translucent(pass, draw.program, draw.material(), draw.vertex_array,
+                             depth)
+                        : draw_key::opaque(pass, draw.program, draw.material(), draw.vertex_array,
+                             depth);
+         submit(key, draw);
+      }
+
+      /// @brief Orders the queued draws by key. Draws with equal keys keep their submission order.
+      ///
+      void sort()
+      {
+         radix_sort(entries_, scratch_);
+      }
+
+      /// @brief Sorts the queue, issues every draw, and then empties the queue.
+      /// @param per_draw Invoked with each draw after its state has been bound, and immediately
+      ///    before it's issued.
+      ///
+      template <ranges::Invocable<draw_call const&> F>
+      void flush(F const& per_draw)
+      {
+         sort();
+         for (auto const& entry : entries_) {
+            auto const& draw = draws_[entry.index];
+            draw.bind();
+            ranges::invoke(per_draw, draw);
+            uniform_uploads::flush(draw.program);
+            if (draw.index_type == gl::NONE)
+               draw_arrays(draw);
+            else
+               draw_elements(draw);
+         }
+
+         clear();
+      }
+
+      void flush()
+      {
+         flush([](draw_call const&) {});
+      }
+
+      /// @brief The queued draws, in the order that they'll be issued if sort() has been called.
+      ///
+      template <ranges::Invocable<draw_key, draw_call const&> F>
+      void for_each(F const& f) const
+      {
+         for (auto const& entry : entries_)
+            ranges::invoke(f, draw_key{entry.key}, draws_[entry.index]);
+      }
+
+      void clear() noexcept
+      {
+         entries_.clear();
+         draws_.clear();
+      }
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return ranges::size(entries_);
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return ranges::empty(entries_);
+      }
+   private:
+      struct entry {
+         std::uint64_t key;
+         std::uint32_t index;
+      };
+
+      std::vector<entry> entries_;
+      std::vector<entry> scratch_;
+      std::vector<draw_call> draws_;
+
+      static void draw_arrays(draw_call const& draw) noexcept
+      {
+         auto const first = gsl::narrow_cast<GLint>(draw.first);
+         if (draw.instances == 1)
+            gl::DrawArrays(draw.mode, first, draw.count);
+         else
+            gl::DrawArraysInstanced(draw.mode, first, draw.count, draw.instances);
+      }
+
+      static void draw_elements(draw_call const& draw) noexcept
+      {
+         auto const indices = reinterpret_cast<void const*>(draw.first);
+         if (draw.instances != 1) {
+            gl::DrawElementsInstancedBaseVertex(draw.mode, draw.count, draw.index_type, indices,
+               draw.instances, draw.base_vertex);
+         }
+         else if (draw.base_vertex != 0) {
+            gl::DrawElementsBaseVertex(draw.mode, draw.count, draw.index_type, indices,
+               draw.base_vertex);
+         }
+         else {
+            gl::DrawElements(draw.mode, draw.count, draw.index_type, indices);
+         }
+      }
+
+      /// @brief A least-significant-digit radix sort on bytes, which is stable, and linear in the
+      ///    number of draws. Bytes that are the same in every key are skipped, which is common,
+      ///    since most scenes only use a few passes and programs.
+      ///
+      static void radix_sort(std::vector<entry>& entries, std::vector<entry>& scratch)
+      {
+         scratch.resize(ranges::size(entries));
+         for (auto shift = 0; shift < 64; shift += 8) {
+            auto offsets = std::array<std::size_t, 256>{};
+            for (auto const& e : entries)
+               ++offsets[(e.key >> shift) & 0xff];
+
+            if (ranges::find(offsets, ranges::size(entries)) != ranges::end(offsets))
+               continue;
+
+            auto total = std::size_t{0};
+            for (auto& offset : offsets)
+               total += std::exchange(offset, total);
+
+            for (auto const& e : entries)
+               scratch[offsets[(e.key >> shift) & 0xff]++] = e;
+            entries.swap(scratch);
+         }
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_GL_RENDER_QUEUE_HPP
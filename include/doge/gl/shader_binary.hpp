@@ -16,7 +16,9 @@
 #ifndef DOGE_GL_SHADER_BINARY_HPP
 #define DOGE_GL_SHADER_BINARY_HPP
 
+#include <doge/gl/program_reflection.hpp>
 #include <doge/gl/shader_source.hpp>
+#include <doge/gl/state_cache.hpp>
 #include <experimental/ranges/concepts>
 #include <experimental/ranges/functional>
 #include <gl/gl_core.hpp>
@@ -38,7 +40,7 @@ namespace doge {
       template <ranges::Invocable F>
       auto use(const F& f) const noexcept
       {
-         gl::UseProgram(index_);
+         state_cache::use_program(index_);
          return ranges::invoke(f);
       }
 
@@ -46,8 +48,16 @@ namespace doge {
       {
          return index_;
       }
+
+      /// @brief The program's active uniforms, blocks, and attributes, as found when it was linked.
+      ///
+      program_reflection const& reflection() const noexcept
+      {
+         return reflection_;
+      }
    private:
       GLuint index_;
+      program_reflection reflection_;
 
       std::vector<shader_source>
       compile_shaders(const std::vector<std::pair<shader_source::type, std::string>>& paths);
@@ -0,0 +1,345 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_STATE_CACHE_HPP
+#define DOGE_GL_STATE_CACHE_HPP
+
+#include <array>
+#include <cstdint>
+#include <doge/gl/direct_state_access.hpp>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/iterator>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <limits>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   enum class capability {
+      blend = gl::BLEND,
+      cull_face = gl::CULL_FACE,
+      depth_test = gl::DEPTH_TEST,
+      scissor_test = gl::SCISSOR_TEST,
+      stencil_test = gl::STENCIL_TEST
+   };
+
+   /// @brief Shadows the context's bindings and enables, so that calls which wouldn't change
+   ///    anything are never made.
+   ///
+   /// Every doge wrapper goes through the cache. Code that changes the same state by calling GL
+   /// directly must call state_cache::invalidate() afterwards, or the cache will drop calls that
+   /// it shouldn't.
+   /// @note There is only one cache, since doge only ever has one context, and that context is
+   ///    only current on one thread at a time.
+   ///
+   class state_cache {
+   public:
+      static void use_program(GLuint const program) noexcept
+      {
+         if (elide(program_ == program))
+            return;
+
+         program_ = program;
+         gl::UseProgram(program);
+      }
+
+      /// @brief The program that's in use, which is only queried if the cache doesn't know.
+      ///
+      [[nodiscard]] static GLuint program() noexcept
+      {
+         if (program_ == unknown) {
+            auto current = GLint{0};
+            gl::GetIntegerv(gl::CURRENT_PROGRAM, &current);
+            program_ = gsl::narrow_cast<GLuint>(current);
+         }
+
+         return program_;
+      }
+
+      static void bind_vertex_array(GLuint const vertex_array) noexcept
+      {
+         if (elide(vertex_array_ == vertex_array))
+            return;
+
+         vertex_array_ = vertex_array;
+         gl::BindVertexArray(vertex_array);
+
+         // The element array binding belongs to the vertex array object.
+         buffers_[buffer_slot(gl::ELEMENT_ARRAY_BUFFER)] = unknown;
+      }
+
+      static void bind_buffer(GLenum const target, GLuint const buffer) noexcept
+      {
+         auto const slot = buffer_slot(target);
+         if (slot == ranges::size(buffer_targets)) {
+            gl::BindBuffer(target, buffer);
+            return;
+         }
+
+         if (elide(buffers_[slot] == buffer))
+            return;
+
+         buffers_[slot] = buffer;
+         gl::BindBuffer(target, buffer);
+      }
+
+      /// @brief Binds buffer to index of an indexed target, such as gl::UNIFORM_BUFFER or
+      ///    gl::SHADER_STORAGE_BUFFER.
+      /// @note Like glBindBufferBase, this also binds buffer to target itself.
+      ///
+      static void bind_buffer_base(GLenum const target, GLuint const index,
+         GLuint const buffer) noexcept
+      {
+         auto const slot = indexed_slot(target);
+         if (slot == ranges::size(indexed_targets) || index >= ranges::size(indexed_buffers_[0])) {
+            gl::BindBufferBase(target, index, buffer);
+            if (auto const generic = buffer_slot(target); generic < ranges::size(buffer_targets))
+               buffers_[generic] = buffer;
+
+            return;
+         }
+
+         auto& generic = buffers_[buffer_slot(target)];
+         if (elide(indexed_buffers_[slot][index] == buffer && generic == buffer))
+            return;
+
+         indexed_buffers_[slot][index] = buffer;
+         generic = buffer;
+         gl::BindBufferBase(target, index, buffer);
+      }
+
+      /// @brief Makes unit the active texture unit, and binds texture to target on it.
+      /// @param unit One of gl::TEXTURE0, gl::TEXTURE1, ...
+      ///
+      static void bind_texture(GLenum const unit, GLenum const target, GLuint const texture) noexcept
+      {
+         Expects(unit >= gl::TEXTURE0);
+         active_texture(unit);
+
+         auto const index = unit - gl::TEXTURE0;
+         auto const slot = texture_slot(target);
+         if (index >= ranges::size(textures_) || slot == ranges::size(texture_targets)) {
+            gl::BindTexture(target, texture);
+            return;
+         }
+
+         if (elide(textures_[index][slot] == texture))
+            return;
+
+         textures_[index][slot] = texture;
+         gl::BindTexture(target, texture);
+      }
+
+      /// @brief Binds texture to target on unit, only changing the active texture unit if the
+      ///    binding changes.
+      /// @note Unlike bind_texture, unit isn't necessarily active afterwards, so this is for binding
+      ///    textures to draw with, not for binding textures to modify.
+      ///
+      static void bind_texture_unit(GLenum const unit, GLenum const target,
+         GLuint const texture) noexcept
+      {
+         Expects(unit >= gl::TEXTURE0);
+         auto const index = unit - gl::TEXTURE0;
+         auto const slot = texture_slot(target);
+         auto const cached = index < ranges::size(textures_) && slot < ranges::size(texture_targets);
+         if (cached && elide(textures_[index][slot] == texture))
+            return;
+
+         // glBindTextureUnit can't unbind just one target, so unbinding goes through bind_texture.
+         if (cached && texture != 0 && direct_state_access::enabled()) {
+            textures_[index][slot] = texture;
+            gl::BindTextureUnit(index, texture);
+            return;
+         }
+
+         bind_texture(unit, target, texture);
+      }
+
+      static void active_texture(GLenum const unit) noexcept
+      {
+         if (elide(active_texture_ == unit))
+            return;
+
+         active_texture_ = unit;
+         gl::ActiveTexture(unit);
+      }
+
+      static void enable(capability const c, bool const enabled = true) noexcept
+      {
+         auto& cached = capabilities_[capability_slot(c)];
+         auto const state = enabled ? tristate::enabled : tristate::disabled;
+         if (elide(cached == state))
+            return;
+
+         cached = state;
+         if (enabled)
+            gl::Enable(static_cast<GLenum>(c));
+         else
+            gl::Disable(static_cast<GLenum>(c));
+      }
+
+      static void disable(capability const c) noexcept
+      {
+         enable(c, false);
+      }
+
+      static void viewport(GLint const x, GLint const y, GLsizei const width,
+         GLsizei const height) noexcept
+      {
+         auto const v = std::array<GLint, 4>{x, y, width, height};
+         if (elide(viewport_valid_ && viewport_ == v))
+            return;
+
+         viewport_ = v;
+         viewport_valid_ = true;
+         gl::Viewport(x, y, width, height);
+      }
+
+      /// @brief Forgets everything that the cache knows, so that the next call of each kind goes
+      ///    through to GL.
+      ///
+      static void invalidate() noexcept
+      {
+         program_ = unknown;
+         vertex_array_ = unknown;
+         active_texture_ = unknown;
+         ranges::fill(buffers_, unknown);
+         for (auto& target : indexed_buffers_)
+            ranges::fill(target, unknown);
+         for (auto& unit : textures_)
+            ranges::fill(unit, unknown);
+         ranges::fill(capabilities_, tristate::unknown);
+         viewport_valid_ = false;
+      }
+
+      /// @brief Deleting an object unbinds it, so the cache must be told about deletions.
+      ///
+      static void deleted_buffers(gsl::span<GLuint const> const buffers) noexcept
+      {
+         for (auto const b : buffers) {
+            ranges::replace(buffers_, b, GLuint{0});
+            for (auto& target : indexed_buffers_)
+               ranges::replace(target, b, GLuint{0});
+         }
+      }
+
+      static void deleted_vertex_arrays(gsl::span<GLuint const> const vertex_arrays) noexcept
+      {
+         if (ranges::find(vertex_arrays, vertex_array_) != ranges::end(vertex_arrays)) {
+            vertex_array_ = 0;
+            buffers_[buffer_slot(gl::ELEMENT_ARRAY_BUFFER)] = unknown;
+         }
+      }
+
+      static void deleted_textures(gsl::span<GLuint const> const textures) noexcept
+      {
+         for (auto const t : textures) {
+            for (auto& unit : textures_)
+               ranges::replace(unit, t, GLuint{0});
+         }
+      }
+
+      /// @brief The number of calls that the cache has dropped, for measuring its effect.
+      ///
+      [[nodiscard]] static std::int64_t elided_calls() noexcept
+      {
+         return elided_calls_;
+      }
+   private:
+      enum class tristate : std::uint8_t { unknown, disabled, enabled };
+
+      static constexpr auto unknown = std::numeric_limits<GLuint>::max();
+
+      static constexpr auto buffer_targets = std::array<GLenum, 12>{
+         gl::ARRAY_BUFFER, gl::ELEMENT_ARRAY_BUFFER, gl::UNIFORM_BUFFER, gl::SHADER_STORAGE_BUFFER,
+         gl::DRAW_INDIRECT_BUFFER, gl::DISPATCH_INDIRECT_BUFFER, gl::COPY_READ_BUFFER,
+         gl::COPY_WRITE_BUFFER, gl::PIXEL_PACK_BUFFER, gl::PIXEL_UNPACK_BUFFER, gl::TEXTURE_BUFFER,
+         gl::ATOMIC_COUNTER_BUFFER
+      };
+
+      static constexpr auto indexed_targets = std::array<GLenum, 2>{
+         gl::UNIFORM_BUFFER, gl::SHADER_STORAGE_BUFFER
+      };
+
+      static constexpr auto texture_targets = std::array<GLenum, 7>{
+         gl::TEXTURE_1D, gl::TEXTURE_2D, gl::TEXTURE_3D, gl::TEXTURE_1D_ARRAY, gl::TEXTURE_2D_ARRAY,
+         gl::TEXTURE_CUBE_MAP, gl::TEXTURE_CUBE_MAP_ARRAY
+      };
+
+      static constexpr auto capabilities = std::array<capability, 5>{
+         capability::blend, capability::cull_face, capability::depth_test,
+         capability::scissor_test, capability::stencil_test
+      };
+
+      static inline GLuint program_ = unknown;
+      static inline GLuint vertex_array_ = unknown;
+      static inline GLuint active_texture_ = unknown;
+      static inline auto buffers_ = [] {
+         auto result = std::array<GLuint, ranges::size(buffer_targets)>{};
+         ranges::fill(result, unknown);
+         return result;
+      }();
+      static inline auto indexed_buffers_ = [] {
+         auto result = std::array<std::array<GLuint, 32>, ranges::size(indexed_targets)>{};
+         for (auto& target : result)
+            ranges::fill(target, unknown);
+         return result;
+      }();
+      static inline auto textures_ = [] {
+         auto result = std::array<std::array<GLuint, ranges::size(texture_targets)>, 32>{};
+         for (auto& unit : result)
+            ranges::fill(unit, unknown);
+         return result;
+      }();
+      static inline auto capabilities_ = std::array<tristate, ranges::size(capabilities)>{};
+      static inline auto viewport_ = std::array<GLint, 4>{};
+      static inline bool viewport_valid_ = false;
+      static inline std::int64_t elided_calls_ = 0;
+
+      static bool elide(bool const redundant) noexcept
+      {
+         elided_calls_ += redundant;
+         return redundant;
+      }
+
+      static std::size_t buffer_slot(GLenum const target) noexcept
+      {
+         return gsl::narrow_cast<std::size_t>(
+            ranges::distance(ranges::begin(buffer_targets), ranges::find(buffer_targets, target)));
+      }
+
+      static std::size_t indexed_slot(GLenum const target) noexcept
+      {
+         return gsl::narrow_cast<std::size_t>(
+            ranges::distance(ranges::begin(indexed_targets), ranges::find(indexed_targets, target)));
+      }
+
+      static std::size_t texture_slot(GLenum const target) noexcept
+      {
+         return gsl::narrow_cast<std::size_t>(
+            ranges::distance(ranges::begin(texture_targets), ranges::find(texture_targets, target)));
+      }
+
+      static std::size_t capability_slot(capability const c) noexcept
+      {
+         return gsl::narrow_cast<std::size_t>(
+            ranges::distance(ranges::begin(capabilities), ranges::find(capabilities, c)));
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_GL_STATE_CACHE_HPP
@@ -0,0 +1,321 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_STREAMING_BUFFER_HPP
+#define DOGE_GL_STREAMING_BUFFER_HPP
+
+#include "doge/gl/direct_state_access.hpp"
+#include "doge/gl/memory.hpp"
+#include "doge/gl/render_queue.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/gl/uniform_uploads.hpp"
+#include "doge/gl/vertex_array.hpp"
+#include "doge/utility/std_layout_tuple.hpp"
+#include <cstddef>
+#include <experimental/ranges/concepts>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <utility>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief A buffer for data that the CPU rewrites every frame, such as particles or debug
+   ///    geometry.
+   ///
+   /// The buffer is split into equally sized regions, which are written in turn, one per frame.
+   /// Each region is written straight into persistently mapped memory, and is fenced once the
+   /// frame's draws have been issued, so the CPU only waits when it gets a whole ring ahead of the
+   /// GPU. Storage is allocated once, and is never orphaned or copied by the driver.
+   ///
+   ///    auto region = particles.map();    // waits until the GPU has finished with the region
+   ///    ranges::copy(live, ranges::begin(region));
+   ///    particles.unmap();
+   ///    draw(particles.first(), ranges::size(live));
+   ///    particles.commit();               // fences the region, and moves on to the next one
+   ///
+   /// @note Without ARB_buffer_storage, each region is mapped unsynchronised when it's written
+   ///    instead, and the fences still stop the CPU from overwriting what the GPU is reading. The
+   ///    region must then be unmapped before it's drawn, which is a no-op for persistent buffers.
+   ///
+   template <typename T>
+   requires
+      StandardLayout<T>
+   class streaming_buffer {
+   public:
+      /// @param capacity The number of Ts in each region.
+      /// @param regions The number of frames that can be in flight at once.
+      ///
+      explicit streaming_buffer(std::size_t const capacity, std::size_t const regions = 3)
+         : capacity_{capacity},
+           fences_(regions, nullptr)
+      {
+         Expects(capacity > 0);
+         Expects(regions > 0);
+
+         auto const size = gsl::narrow_cast<GLsizeiptr>(capacity * regions * sizeof(T));
+         if (persistent()) {
+            constexpr auto flags = GLbitfield{gl::MAP_WRITE_BIT | gl::MAP_PERSISTENT_BIT
+               | gl::MAP_COHERENT_BIT};
+            if (direct_state_access::enabled()) {
+               gl::NamedBufferStorage(*buffer_, size, nullptr, flags);
+               mapped_ = static_cast<T*>(gl::MapNamedBufferRange(*buffer_, 0, size, flags));
+            }
+            else {
+               state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *buffer_);
+               gl::BufferStorage(gl::COPY_WRITE_BUFFER, size, nullptr, flags);
+               mapped_ = static_cast<T*>(gl::MapBufferRange(gl::COPY_WRITE_BUFFER, 0, size, flags));
+            }
+         }
+         else if (direct_state_access::enabled()) {
+            gl::NamedBufferData(*buffer_, size, nullptr, gl::STREAM_DRAW);
+         }
+         else {
+            state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *buffer_);
+            gl::BufferData(gl::COPY_WRITE_BUFFER, size, nullptr, gl::STREAM_DRAW);
+         }
+      }
+
+      streaming_buffer(streaming_buffer&& other) noexcept
+         : buffer_{std::move(other.buffer_)},
+           capacity_{other.capacity_},
+           fences_{std::move(other.fences_)},
+           region_{other.region_},
+           mapped_{std::exchange(other.mapped_, nullptr)},
+           region_mapped_{std::exchange(other.region_mapped_, false)}
+      {
+         other.fences_.clear();
+      }
+
+      streaming_buffer& operator=(streaming_buffer&& other) noexcept
+      {
+         if (this != &other) {
+            delete_fences();
+            buffer_ = std::move(other.buffer_);
+            capacity_ = other.capacity_;
+            fences_ = std::move(other.fences_);
+            other.fences_.clear();
+            region_ = other.region_;
+            mapped_ = std::exchange(other.mapped_, nullptr);
+            region_mapped_ = std::exchange(other.region_mapped_, false);
+         }
+
+         return *this;
+      }
+
+      /// @note Deleting the buffer unmaps it.
+      ///
+      ~streaming_buffer()
+      {
+         delete_fences();
+      }
+
+      /// @brief The current region, which can be written until unmap() or commit() is called.
+      /// @note Waits for the GPU to finish reading the region, if it hasn't already.
+      ///
+      [[nodiscard]] gsl::span<T> map() noexcept
+      {
+         wait(fences_[region_]);
+         if (persistent())
+            return {mapped_ + first(), gsl::narrow_cast<std::ptrdiff_t>(capacity_)};
+
+         if (not region_mapped_) {
+            constexpr auto flags = GLbitfield{gl::MAP_WRITE_BIT | gl::MAP_INVALIDATE_RANGE_BIT
+               | gl::MAP_UNSYNCHRONIZED_BIT};
+            auto const size = gsl::narrow_cast<GLsizeiptr>(capacity_ * sizeof(T));
+            if (direct_state_access::enabled()) {
+               mapped_ = static_cast<T*>(gl::MapNamedBufferRange(*buffer_, offset(), size, flags));
+            }
+            else {
+               state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *buffer_);
+               mapped_ = static_cast<T*>(gl::MapBufferRange(gl::COPY_WRITE_BUFFER, offset(), size,
+                  flags));
+            }
+            region_mapped_ = true;
+         }
+
+         return {mapped_, gsl::narrow_cast<std::ptrdiff_t>(capacity_)};
+      }
+
+      /// @brief Finishes writing the current region, so that it can be drawn.
+      ///
+      void unmap() noexcept
+      {
+         if (not region_mapped_)
+            return;
+
+         if (direct_state_access::enabled()) {
+            gl::UnmapNamedBuffer(*buffer_);
+         }
+         else {
+            state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *buffer_);
+            gl::UnmapBuffer(gl::COPY_WRITE_BUFFER);
+         }
+         region_mapped_ = false;
+      }
+
+      /// @brief Fences the current region after the draws that have been issued so far, and moves
+      ///    on to the next region.
+      ///
+      void commit() noexcept
+      {
+         unmap();
+         fences_[region_] = gl::FenceSync(gl::SYNC_GPU_COMMANDS_COMPLETE, 0);
+         region_ = (region_ + 1) % ranges::size(fences_);
+      }
+
+      /// @brief The index of the current region's first element, for use as a draw's first vertex.
+      ///
+      [[nodiscard]] GLint first() const noexcept
+      {
+         return gsl::narrow_cast<GLint>(region_ * capacity_);
+      }
+
+      /// @brief The byte offset of the current region.
+      ///
+      [[nodiscard]] GLintptr offset() const noexcept
+      {
+         return gsl::narrow_cast<GLintptr>(first() * sizeof(T));
+      }
+
+      [[nodiscard]] std::size_t capacity() const noexcept
+      {
+         return capacity_;
+      }
+
+      [[nodiscard]] GLuint get() const noexcept
+      {
+         return *buffer_;
+      }
+
+      /// @brief Determines whether the buffer is persistently mapped, or mapped each frame.
+      ///
+      [[nodiscard]] static bool persistent() noexcept
+      {
+         auto const& extension = gl::exts::var_ARB_buffer_storage;
+         return extension && extension.GetNumMissing() == 0;
+      }
+   private:
+      gpu_ptr<resource_type::buffer> buffer_;
+      std::size_t capacity_;
+      std::vector<GLsync> fences_;
+      std::size_t region_ = 0;
+      T* mapped_ = nullptr;
+      bool region_mapped_ = false;
+
+      static void wait(GLsync& fence) noexcept
+      {
+         if (fence == nullptr)
+            return;
+
+         constexpr auto one_second = GLuint64{1'000'000'000};
+         while (gl::ClientWaitSync(fence, gl::SYNC_FLUSH_COMMANDS_BIT, one_second)
+            == gl::TIMEOUT_EXPIRED) {
+         }
+
+         gl::DeleteSync(fence);
+         fence = nullptr;
+      }
+
+      void delete_fences() noexcept
+      {
+         for (auto const fence : fences_)
+            gl::DeleteSync(fence);
+      }
+   };
+
+   /// @brief A vertex array whose vertices are rewritten every frame, through a streaming_buffer.
+   ///
+   /// Every region is read through the same vertex array, by starting each draw at the current
+   /// region's first vertex, so nothing is rebound when the region changes.
+   ///
+   template <typename... Ts>
+   requires
+      (StandardLayout<Ts> && ...) &&
+      ((detail::attribute_traits<Ts>::components <= 4) && ...)
+   class streaming_vertex_array_buffer {
+   public:
+      /// @param capacity The number of vertices that can be drawn each frame.
+      /// @param regions The number of frames that can be in flight at once.
+      ///
+      explicit streaming_vertex_array_buffer(std::size_t const capacity,
+         std::size_t const regions = 3)
+         : vbo_{capacity, regions}
+      {
+         detail::vertex_format<Ts...>::attach(*vao_, vbo_.get());
+      }
+
+      /// @copydoc streaming_buffer::map
+      ///
+      [[nodiscard]] gsl::span<std_layout_tuple<Ts...>> map() noexcept
+      {
+         return vbo_.map();
+      }
+
+      /// @copydoc streaming_buffer::unmap
+      ///
+      void unmap() noexcept
+      {
+         vbo_.unmap();
+      }
+
+      /// @copydoc streaming_buffer::commit
+      ///
+      void commit() noexcept
+      {
+         vbo_.commit();
+      }
+
+      template <ranges::Invocable F>
+      void bind(F const& f) const noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      {
+         state_cache::bind_vertex_array(*vao_);
+         ranges::invoke(f);
+      }
+
+      /// @brief Draws the first count vertices of the current region, unmapping it if need be.
+      ///
+      template <ranges::Invocable F>
+      void draw(GLsizei const count, F const& f) noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      {
+         Expects(0 <= count && static_cast<std::size_t>(count) <= vbo_.capacity());
+         vbo_.unmap();
+         bind([this, count, f]{
+            ranges::invoke(f);
+            uniform_uploads::flush();
+            gl::DrawArrays(gl::TRIANGLES, vbo_.first(), count);
+         });
+      }
+
+      /// @brief Describes what draw(count, f) issues, so that it can be submitted to a
+      ///    render_queue. The region must be unmapped before the queue is flushed, and the queue
+      ///    must be flushed before commit() is called.
+      ///
+      [[nodiscard]] draw_call as_draw_call(GLsizei const count) const noexcept
+      {
+         auto result = draw_call{};
+         result.vertex_array = *vao_;
+         result.first = vbo_.first();
+         result.count = count;
+         return result;
+      }
+   private:
+      streaming_buffer<std_layout_tuple<Ts...>> vbo_;
+      gpu_ptr<resource_type::vertex_array> vao_;
+   };
+} // namespace doge
+
+#endif // DOGE_GL_STREAMING_BUFFER_HPP
@@ -16,7 +16,10 @@
 #ifndef DOGE_GL_TEXTURE_HPP
 #define DOGE_GL_TEXTURE_HPP
 
+#include <algorithm>
 #include <array>
+#include <doge/gl/direct_state_access.hpp>
+#include <doge/gl/state_cache.hpp>
 #include <doge/utility/reference_count.hpp>
 #include <doge/utility/type_traits.hpp>
 #include <experimental/ranges/algorithm>
@@ -42,20 +45,26 @@ namespace doge {
    class basic_texture;
 
    template <texture_t Kind>
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, GLfloat param) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, GLfloat param) noexcept
    {
-      gl::TexParameterf(static_cast<GLenum>(Kind), pname, param);
+      if (direct_state_access::enabled())
+         gl::TextureParameterf(static_cast<GLuint>(tex), pname, param);
+      else
+         gl::TexParameterf(static_cast<GLenum>(Kind), pname, param);
    }
 
    template <texture_t Kind, typename I>
    requires
       (ranges::Integral<I> ||
        std::is_enum_v<I>)
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, I param) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, I param) noexcept
    {
       Expects(std::numeric_limits<GLint>::min() <= static_cast<GLint>(param));
       Expects(static_cast<GLint>(param) <= std::numeric_limits<GLint>::max());
-      gl::TexParameteri(static_cast<GLenum>(Kind), pname, static_cast<GLint>(param));
+      if (direct_state_access::enabled())
+         gl::TextureParameteri(static_cast<GLuint>(tex), pname, static_cast<GLint>(param));
+      else
+         gl::TexParameteri(static_cast<GLenum>(Kind), pname, static_cast<GLint>(param));
    }
 
    template <texture_t Kind, ranges::RandomAccessIterator Rng>
@@ -64,17 +73,23 @@ namespace doge {
          ranges::Same<ranges::value_type_t<Rng>, GLfloat>;
          {ranges::data(rng)} -> ranges::value_type_t<Rng>*;
       }
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, const Rng& params) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, const Rng& params) noexcept
    {
-      gl::TexParameterfv(static_cast<GLenum>(Kind), pname, ranges::data(params));
+      if (direct_state_access::enabled())
+         gl::TextureParameterfv(static_cast<GLuint>(tex), pname, ranges::data(params));
+      else
+         gl::TexParameterfv(static_cast<GLenum>(Kind), pname, ranges::data(params));
    }
 
    template <texture_t Kind, typename V>
    requires
       detail::type_is_glm_vec<GLfloat, V>
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, const V& params) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, const V& params) noexcept
    {
-      gl::TexParameterfv(static_cast<GLenum>(Kind), pname, std::addressof(params));
+      if (direct_state_access::enabled())
+         gl::TextureParameterfv(static_cast<GLuint>(tex), pname, std::addressof(params));
+      else
+         gl::TexParameterfv(static_cast<GLenum>(Kind), pname, std::addressof(params));
    }
 
    template <texture_t Kind, ranges::RandomAccessIterator Rng>
@@ -83,17 +98,23 @@ namespace doge {
          ranges::Same<ranges::value_type_t<Rng>, GLint>;
          {ranges::data(rng)} -> ranges::value_type_t<Rng>*;
       }
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, const Rng& params) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, const Rng& params) noexcept
    {
-      gl::TexParameterIiv(static_cast<GLenum>(Kind), pname, ranges::data(params));
+      if (direct_state_access::enabled())
+         gl::TextureParameterIiv(static_cast<GLuint>(tex), pname, ranges::data(params));
+      else
+         gl::TexParameterIiv(static_cast<GLenum>(Kind), pname, ranges::data(params));
    }
 
    template <texture_t Kind, typename V>
    requires
       detail::type_is_glm_vec<GLint, V>
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, const V& params) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, const V& params) noexcept
    {
-      gl::TexParameterIiv(static_cast<GLenum>(Kind), pname, std::addressof(params));
+      if (direct_state_access::enabled())
+         gl::TextureParameterIiv(static_cast<GLuint>(tex), pname, std::addressof(params));
+      else
+         gl::TexParameterIiv(static_cast<GLenum>(Kind), pname, std::addressof(params));
    }
 
    template <texture_t Kind, ranges::RandomAccessIterator Rng>
@@ -101,17 +122,23 @@ namespace doge {
          ranges::Same<ranges::value_type_t<Rng>, GLuint>;
          {ranges::data(rng)} -> ranges::value_type_t<Rng>*;
    }
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, const Rng& params) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, const Rng& params) noexcept
    {
-      gl::TexParameterIuiv(static_cast<GLenum>(Kind), pname, ranges::data(params));
+      if (direct_state_access::enabled())
+         gl::TextureParameterIuiv(static_cast<GLuint>(tex), pname, ranges::data(params));
+      else
+         gl::TexParameterIuiv(static_cast<GLenum>(Kind), pname, ranges::data(params));
    }
 
    template <texture_t Kind, typename V>
    requires
       detail::type_is_glm_vec<GLuint, V>
-   void texture_parameter(const basic_texture<Kind>&, GLenum pname, const V& params) noexcept
+   void texture_parameter(const basic_texture<Kind>& tex, GLenum pname, const V& params) noexcept
    {
-      gl::TexParameterIuiv(static_cast<GLenum>(Kind), pname, std::addressof(params));
+      if (direct_state_access::enabled())
+         gl::TextureParameterIuiv(static_cast<GLuint>(tex), pname, std::addressof(params));
+      else
+         gl::TexParameterIuiv(static_cast<GLenum>(Kind), pname, std::addressof(params));
    }
 
    using texture1d = basic_texture<texture_t::texture_1d>;
@@ -229,10 +256,16 @@ namespace doge {
          : index_{
                [this]{
                  ranges::Integral object_ = GLuint{};
-                 gl::GenTextures(size_, &object_);
+                 if (direct_state_access::enabled())
+                    gl::CreateTextures(static_cast<GLenum>(Kind), size_, &object_);
+                 else
+                    gl::GenTextures(size_, &object_);
                  return object_;
               }(),
-              [this](GLuint* i) noexcept { gl::DeleteTextures(size_, i); }
+              [this](GLuint* i) noexcept {
+                 gl::DeleteTextures(size_, i);
+                 state_cache::deleted_textures({i, size_});
+              }
            }
       {
          ranges::SignedIntegral width = 0;
@@ -249,11 +282,26 @@ namespace doge {
          GLenum format = channels == 1 ? gl::RED
                        : channels == 3 ? gl::RGB : gl::RGBA;
 
-         bind(gl::TEXTURE0 + n);
-         
-         gl::TexImage2D(static_cast<GLenum>(Kind), 0, format, width, height, 0, format,
-            gl::UNSIGNED_BYTE, data.get());
-         gl::GenerateMipmap(static_cast<GLenum>(Kind));
+         if (direct_state_access::enabled()) {
+            // Immutable storage needs a sized format, and room for every mipmap level up front.
+            GLenum internal_format = channels == 1 ? gl::R8
+                                   : channels == 3 ? gl::RGB8 : gl::RGBA8;
+            auto levels = GLsizei{1};
+            for (auto size = std::max(width, height); size > 1; size /= 2)
+               ++levels;
+
+            gl::TextureStorage2D(index_, levels, internal_format, width, height);
+            gl::TextureSubImage2D(index_, 0, 0, 0, width, height, format, gl::UNSIGNED_BYTE,
+               data.get());
+            gl::GenerateTextureMipmap(index_);
+         }
+         else {
+            bind(gl::TEXTURE0 + n);
+
+            gl::TexImage2D(static_cast<GLenum>(Kind), 0, format, width, height, 0, format,
+               gl::UNSIGNED_BYTE, data.get());
+            gl::GenerateMipmap(static_cast<GLenum>(Kind));
+         }
 
          std::apply([this](auto&&... args) noexcept {
             doge::wrap(*this, std::forward<decltype(args)>(args)...); }, wrapping);
@@ -265,8 +313,7 @@ namespace doge {
       void bind(const GLenum active_texture) const noexcept
       {
          Expects(gl::TEXTURE0 <= active_texture && active_texture <= gl::TEXTURE16);
-         gl::ActiveTexture(active_texture);
-         gl::BindTexture(static_cast<GLenum>(Kind), index_);
+         state_cache::bind_texture(active_texture, static_cast<GLenum>(Kind), index_);
       }
 
       template <ranges::Invocable F>
@@ -275,6 +322,11 @@ namespace doge {
          bind(active_texture);
          ranges::invoke(f);
       }
+
+      explicit operator GLuint() const noexcept
+      {
+         return index_;
+      }
    private:
       static constexpr GLuint size_ = 1;
       //GLuint object_;
@@ -21,6 +21,7 @@
 #include "doge/gl/cast.hpp"
 #include "doge/gl/shader_binary.hpp"
 #include "doge/gl/gl_error.hpp"
+#include "doge/gl/uniform_uploads.hpp"
 #include <gl/gl_core.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -54,11 +55,11 @@ namespace doge {
    class uniform;
 
    namespace detail {
-      inline GLint find_location(const shader_binary& program, const std::string_view id)
+      inline GLint find_location(const shader_binary& program, const resource_name id)
       {
-         if (ranges::SignedIntegral i = gl::GetUniformLocation(static_cast<GLuint>(program), id.data()); i >= 0)
-            return i;
-         throw uniform_not_found{id.data()};
+         if (auto const* const u = program.reflection().uniform(id))
+            return u->location;
+         throw uniform_not_found{std::string{id.name()}};
       }
 
       template <class T>
@@ -114,6 +115,16 @@ namespace doge {
                  }()
               }
          {}
+
+         /// @brief Takes over a writable uniform's location and value, for moving a uniform<T2>
+         ///    into a uniform<T const>.
+         ///
+         template <typename T2>
+         uniform_data(uniform_data<T2>&& other) noexcept
+            : program_{other.program_},
+              location_{other.location_},
+              value_{std::move(other.value_)}
+         {}
       };
    }
 
@@ -123,21 +134,21 @@ namespace doge {
    template <ranges::DefaultConstructible T>
    class uniform {
    public:
-      uniform(const shader_binary& program, const std::string_view id)
+      uniform(const shader_binary& program, const resource_name id)
       requires
          std::is_const_v<T> &&
          detail::is_glm_GLfloat<T>
          : uniform{program, id, gl::GetUniformfv}
       {}
 
-      uniform(const shader_binary& program, const std::string_view id)
+      uniform(const shader_binary& program, const resource_name id)
       requires
          std::is_const_v<T> &&
          detail::is_glm_GLint<T>
          : uniform{program, id, gl::GetUniformiv}
       {}
 
-      uniform(const shader_binary& program, const std::string_view id)
+      uniform(const shader_binary& program, const resource_name id)
       requires
          std::is_const_v<T> &&
          detail::is_glm_GLuint<T>
@@ -145,174 +156,174 @@ namespace doge {
       {}
 
       template <ranges::ConvertibleTo<T> T2>
-      uniform(const shader_binary& program, const std::string_view id, const T2& t2)
+      uniform(const shader_binary& program, const resource_name id, const T2& t2)
          : uniform{program, id, gsl::narrow_cast<T>(t2)}
       {}
 
-      uniform(const shader_binary& program, const std::string_view id, const GLfloat v)
+      uniform(const shader_binary& program, const resource_name id, const GLfloat v)
       requires
          ranges::Same<T, GLfloat>
          : uniform{program, id, gl::Uniform1f, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, GLfloat>
       //    : uniform{program, id, gl::Uniform1fv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::vec2& v)
+      uniform(const shader_binary& program, const resource_name id, const glm::vec2& v)
       requires
          ranges::Same<T, glm::vec2>
          : uniform{program, id, gl::Uniform2f, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::vec2>
       //    : uniform{program, id, gl::Uniform2fv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::vec3& v)
+      uniform(const shader_binary& program, const resource_name id, const glm::vec3& v)
       requires
          ranges::Same<T, glm::vec3>
          : uniform{program, id, gl::Uniform3f, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::vec3>
       //    : uniform{program, id, gl::Uniform3fv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::vec4& v)
+      uniform(const shader_binary& program, const resource_name id, const glm::vec4& v)
       requires
          ranges::Same<T, glm::vec4>
          : uniform{program, id, gl::Uniform4f, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::vec4>
       //    : uniform{program, id, gl::Uniform4fv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const GLint i)
+      uniform(const shader_binary& program, const resource_name id, const GLint i)
       requires
          ranges::Same<T, GLint>
          : uniform{program, id, gl::Uniform1i, i}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, GLint>
       //    : uniform{program, id, gl::Uniform1iv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::ivec2 v)
+      uniform(const shader_binary& program, const resource_name id, const glm::ivec2 v)
       requires
          ranges::Same<T, glm::ivec2>
          : uniform{program, id, gl::Uniform2i, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::ivec2>
       //    : uniform{program, id, gl::Uniform2iv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::ivec3 v)
+      uniform(const shader_binary& program, const resource_name id, const glm::ivec3 v)
       requires
          ranges::Same<T, glm::ivec3>
          : uniform{program, id, gl::Uniform3i, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::ivec3>
       //    : uniform{program, id, gl::Uniform3iv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::ivec4 v)
+      uniform(const shader_binary& program, const resource_name id, const glm::ivec4 v)
       requires
          ranges::Same<T, glm::ivec4>
          : uniform{program, id, gl::Uniform4i, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::ivec4>
       //    : uniform{program, id, gl::Uniform4iv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const GLuint v)
+      uniform(const shader_binary& program, const resource_name id, const GLuint v)
       requires
          ranges::Same<T, GLuint>
          : uniform{program, id, gl::Uniform1ui, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, GLuint>
       //    : uniform{program, id, gl::Uniform1uiv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::uvec2 v)
+      uniform(const shader_binary& program, const resource_name id, const glm::uvec2 v)
       requires
          ranges::Same<T, glm::uvec2>
          : uniform{program, id, gl::Uniform2ui, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::uvec2>
       //    : uniform{program, id, gl::Uniform2uiv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::uvec3 v)
+      uniform(const shader_binary& program, const resource_name id, const glm::uvec3 v)
       requires
          ranges::Same<T, glm::uvec3>
          : uniform{program, id, gl::Uniform3ui, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::uvec3>
       //    : uniform{program, id, gl::Uniform3uiv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const glm::uvec4 v)
+      uniform(const shader_binary& program, const resource_name id, const glm::uvec4 v)
       requires
          ranges::Same<T, glm::uvec4>
          : uniform{program, id, gl::Uniform4ui, v}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const T& rng)
+      // uniform(const shader_binary& program, const resource_name id, const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
       //    ranges::Same<ranges::data_.value_type_t<T>, glm::uvec4>
       //    : uniform{program, id, gl::Uniform4uiv, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat2x2& m)
       requires
          ranges::Same<T, glm::mat2x2>
          : uniform{program, id, 1, transpose, gl::UniformMatrix2fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -320,14 +331,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix2fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat3x3& m)
       requires
          ranges::Same<T, glm::mat3x3>
          : uniform{program, id, 1, transpose, gl::UniformMatrix3fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -335,14 +346,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix3fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat4x4& m)
       requires
          ranges::Same<T, glm::mat4x4>
          : uniform{program, id, 1, transpose, gl::UniformMatrix4fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -350,14 +361,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix4fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat2x3& m)
       requires
          ranges::Same<T, glm::mat2x3>
          : uniform{program, id, 1, transpose, gl::UniformMatrix2x3fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -365,14 +376,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix2x3fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat3x2& m)
       requires
          ranges::Same<T, glm::mat3x2>
          : uniform{program, id, 1, transpose, gl::UniformMatrix3x2fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -380,14 +391,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix3x2fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat4x2& m)
       requires
          ranges::Same<T, glm::mat4x2>
          : uniform{program, id, 1, transpose, gl::UniformMatrix4x2fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -395,14 +406,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix4x2fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat2x4& m)
       requires
          ranges::Same<T, glm::mat2x4>
          : uniform{program, id, 1, transpose, gl::UniformMatrix2x4fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -410,14 +421,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix2x4fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat4x3& m)
       requires
          ranges::Same<T, glm::mat4x3>
          : uniform{program, id, 1, transpose, gl::UniformMatrix4x3fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -425,14 +436,14 @@ namespace doge {
       //    : uniform{program, id, gl::UniformMatrix4x3fv, transpose, rng}
       // {}
 
-      uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      uniform(const shader_binary& program, const resource_name id, const bool transpose,
          const glm::mat3x4& m)
       requires
          ranges::Same<T, glm::mat3x4>
          : uniform{program, id, 1, transpose, gl::UniformMatrix3x4fv, m}
       {}
 
-      // uniform(const shader_binary& program, const std::string_view id, const bool transpose,
+      // uniform(const shader_binary& program, const resource_name id, const bool transpose,
       //    const T& rng)
       // requires
       //    ranges::RandomAccessRange<T> &&
@@ -448,6 +459,7 @@ namespace doge {
       uniform(uniform&& t) noexcept(noexcept(std::is_nothrow_move_constructible_v<T>))
          : data_{std::move(t.data_)}
       {
+         take_upload(t);
          t.data_.program_ = {};
          t.data_.location_ = {};
          t.data_.value_ = {};
@@ -457,11 +469,20 @@ namespace doge {
       uniform(uniform<T2>&& t) noexcept(noexcept(std::is_nothrow_constructible_v<T, T2>))
          : data_{std::move(t.data_)}
       {
+         take_upload(t);
          t.data_.program_ = {};
          t.data_.location_ = {};
          t.data_.value_ = {};
       }
 
+      /// @note A deferred value that hasn't been uploaded yet is discarded.
+      ///
+      ~uniform()
+      {
+         if (dirty_)
+            uniform_uploads::forget(this);
+      }
+
       uniform& operator=(const uniform& t) noexcept(noexcept(std::is_nothrow_copy_assignable_v<T>))
       requires
          not std::is_const_v<T>
@@ -484,7 +505,7 @@ namespace doge {
          noexcept(noexcept(std::is_nothrow_constructible_v<T, T2> && std::is_nothrow_copy_assignable_v<T>))
       {
          data_.value_ = gsl::narrow_cast<T>(std::forward<T2>(t));
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -514,7 +535,7 @@ namespace doge {
       uniform& operator+=(const T2& t2) noexcept
       {
          data_.value_ += t2;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -534,7 +555,7 @@ namespace doge {
       uniform& operator-=(const T2& t2) noexcept
       {
          data_.value_ -= t2;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -554,7 +575,7 @@ namespace doge {
       uniform& operator*=(const T2& t2) noexcept
       {
          data_.value_ *= t2;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -575,7 +596,7 @@ namespace doge {
       {
          Expects(t2 != T2{});
          data_.value_ /= t2;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -600,7 +621,7 @@ namespace doge {
       {
          Expects(t2 != T2{});
          data_.value_ %= t2;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -612,7 +633,7 @@ namespace doge {
       }
       {
          ++data_.value_;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -636,7 +657,7 @@ namespace doge {
       }
       {
          --data_.value_;
-         set_uniform("");
+         changed();
          return *this;
       }
 
@@ -928,15 +949,63 @@ namespace doge {
          return not(a < b);
       }
    private:
+      template <ranges::DefaultConstructible>
+      friend class uniform;
+
       detail::uniform_data<T> data_;
+      bool dirty_ = false;
+
+      /// @brief Uploads the new value now, or marks it for upload before the program next draws.
+      ///
+      void changed()
+      {
+         if (uniform_uploads::mode() == uniform_upload::immediate) {
+            set_uniform("");
+            return;
+         }
+
+         if (not dirty_) {
+            dirty_ = true;
+            uniform_uploads::mark(data_.program_, this, [](void* const self) {
+               auto& u = *static_cast<uniform*>(self);
+               u.dirty_ = false;
+               u.set_uniform("");
+            });
+         }
+      }
+
+      /// @brief Moves t's pending upload, if it has one, to this uniform.
+      ///
+      /// A uniform<T const> can't upload anything itself, so t's value is uploaded straight away.
+      ///
+      template <typename T2>
+      void take_upload(uniform<T2>& t)
+      {
+         if constexpr (not std::is_const_v<T2>) {
+            if (not t.dirty_)
+               return;
+
+            uniform_uploads::forget(&t);
+            t.dirty_ = false;
+            if constexpr (std::is_const_v<T>) {
+               auto const previous = state_cache::program();
+               state_cache::use_program(t.data_.program_);
+               t.set_uniform("");
+               state_cache::use_program(previous);
+            }
+            else {
+               changed();
+            }
+         }
+      }
 
-      uniform(const shader_binary& program, const std::string_view id,
+      uniform(const shader_binary& program, const resource_name id,
          const detail::get_uniform_function_t<std::remove_cv_t<T>>& f)
          : data_{program, ::doge::detail::find_location(program, id), f}
       {}
 
       template <typename F>
-      uniform(const shader_binary&, const std::string_view, const F&)
+      uniform(const shader_binary&, const resource_name, const F&)
       requires
          ranges::RandomAccessRange<T> = delete; // TODO
 
@@ -944,44 +1013,44 @@ namespace doge {
       };
 
       template <typename F1, typename... Args>
-      uniform(const set_constructor_t, const shader_binary& program, const std::string_view id,
+      uniform(const set_constructor_t, const shader_binary& program, const resource_name id,
          const F1& f1, Args&&... args)
          : data_{f1, static_cast<GLuint>(program), ::doge::detail::find_location(program, id),
             std::forward<Args>(args)...}
       {
-         set_uniform(id);
+         set_uniform(id.name());
       }
 
       template <typename F, glm::length_t C, glm::length_t R, typename T2, glm::qualifier Q>
-      uniform(const shader_binary& program, const std::string_view id, const GLsizei count,
+      uniform(const shader_binary& program, const resource_name id, const GLsizei count,
          const bool transpose, const F& f, const glm::mat<C, R, T2, Q>& matrix)
          : data_{f, static_cast<GLuint>(program), ::doge::detail::find_location(program, id),
               count, transpose, matrix}
       {
-         gl::UseProgram(data_.program_);
-         set_uniform(id);
+         state_cache::use_program(data_.program_);
+         set_uniform(id.name());
       }
 
       template <typename F1>
-      uniform(const shader_binary& program, const std::string_view id, const F1& f1,
+      uniform(const shader_binary& program, const resource_name id, const F1& f1,
          const T t)
          : uniform{set_constructor_t{}, program, id, f1, t}
       {}
 
       template <typename F1>
-      uniform(const shader_binary& program, const std::string_view id, const F1& f1,
+      uniform(const shader_binary& program, const resource_name id, const F1& f1,
          const glm::tvec2<T>& v)
          : uniform{set_constructor_t{}, program, id, f1, v.x, v.y}
       {}
 
       template <typename F1>
-      uniform(const shader_binary& program, const std::string_view id, const F1& f1,
+      uniform(const shader_binary& program, const resource_name id, const F1& f1,
          const glm::tvec3<T>& v)
          : uniform{set_constructor_t{}, program, id, f1, v.x, v.y, v.z}
       {}
 
       template <typename F1>
-      uniform(const shader_binary& program, const std::string_view id, const F1& f1,
+      uniform(const shader_binary& program, const resource_name id, const F1& f1,
          const glm::tvec4<T>& v)
          : uniform{set_constructor_t{}, program, id, f1, v.x, v.y, v.z, v.w}
       {}
@@ -1007,12 +1076,12 @@ namespace doge {
                glm::value_ptr(data_.value_));
          }
 
-         check_error(std::string{id});
+         error_checking::check_call(id);
       }
    };
 
    template <ranges::DefaultConstructible T>
-   uniform(const shader_binary&, std::string_view, T) -> uniform<T>;
+   uniform(const shader_binary&, resource_name, T) -> uniform<T>;
 } // namespace doge
 
 #endif // DOGE_GL_UNIFORM_HPP
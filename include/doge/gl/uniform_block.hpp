@@ -0,0 +1,293 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_UNIFORM_BLOCK_HPP
+#define DOGE_GL_UNIFORM_BLOCK_HPP
+
+#include "doge/gl/buffer.hpp"
+#include "doge/gl/direct_state_access.hpp"
+#include "doge/gl/memory.hpp"
+#include "doge/gl/program_reflection.hpp"
+#include "doge/gl/shader_binary.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/utility/std_layout_tuple.hpp"
+#include "doge/utility/type_traits.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <experimental/ranges/concepts>
+#include <gl/gl_core.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief The rules that GLSL uses to lay out the members of an interface block.
+   /// @note std430 is only available to shader storage blocks.
+   ///
+   enum class block_layout { std140, std430 };
+
+   namespace detail {
+      constexpr std::size_t round_up(std::size_t const n, std::size_t const alignment) noexcept
+      {
+         return (n + alignment - 1) / alignment * alignment;
+      }
+
+      /// @brief The base alignment and size of T when it's a member of a block with layout L, and
+      ///    how to copy T into a block.
+      ///
+      template <block_layout L, typename T>
+      struct block_member;
+
+      template <block_layout L, typename T>
+      requires
+         is_one_of_v<T, GLfloat, GLint, GLuint, GLdouble>
+      struct block_member<L, T> {
+         static constexpr std::size_t alignment = sizeof(T);
+         static constexpr std::size_t size = sizeof(T);
+
+         static void pack(std::byte* const out, T const& t) noexcept
+         {
+            std::memcpy(out, &t, sizeof(T));
+         }
+      };
+
+      // GLSL's bool is as wide as a uint.
+      template <block_layout L>
+      struct block_member<L, bool> {
+         static constexpr std::size_t alignment = sizeof(GLuint);
+         static constexpr std::size_t size = sizeof(GLuint);
+
+         static void pack(std::byte* const out, bool const b) noexcept
+         {
+            block_member<L, GLuint>::pack(out, GLuint{b});
+         }
+      };
+
+      template <block_layout L, glm::length_t N, typename T, glm::qualifier Q>
+      struct block_member<L, glm::vec<N, T, Q>> {
+         static constexpr std::size_t alignment = (N == 3 ? 4 : N) * sizeof(T);
+         static constexpr std::size_t size = N * sizeof(T);
+
+         static void pack(std::byte* const out, glm::vec<N, T, Q> const& v) noexcept
+         {
+            std::memcpy(out, glm::value_ptr(v), size);
+         }
+      };
+
+      // Arrays are padded so that each element starts on its base alignment, which std140 also
+      // rounds up to that of a vec4.
+      template <block_layout L, typename T, std::size_t N>
+      struct block_member<L, std::array<T, N>> {
+         static constexpr std::size_t alignment = L == block_layout::std140
+            ? round_up(block_member<L, T>::alignment, 16)
+            : block_member<L, T>::alignment;
+         static constexpr std::size_t stride = round_up(block_member<L, T>::size, alignment);
+         static constexpr std::size_t size = N * stride;
+
+         static void pack(std::byte* const out, std::array<T, N> const& a) noexcept
+         {
+            for (auto i = std::size_t{0}; i < N; ++i)
+               block_member<L, T>::pack(out + i * stride, a[i]);
+         }
+      };
+
+      // Matrices are laid out as arrays of their column vectors.
+      template <block_layout L, glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+      struct block_member<L, glm::mat<C, R, T, Q>> {
+         using columns = block_member<L, std::array<glm::vec<R, T, Q>, C>>;
+         static constexpr std::size_t alignment = columns::alignment;
+         static constexpr std::size_t size = columns::size;
+
+         static void pack(std::byte* const out, glm::mat<C, R, T, Q> const& m) noexcept
+         {
+            for (auto i = glm::length_t{0}; i < C; ++i)
+               block_member<L, glm::vec<R, T, Q>>::pack(out + i * columns::stride, m[i]);
+         }
+      };
+
+      template <block_layout L, typename... Ts>
+      struct block_members {
+         static constexpr std::size_t alignment = [] {
+            auto result = std::max({std::size_t{1}, block_member<L, Ts>::alignment...});
+            return L == block_layout::std140 ? round_up(result, 16) : result;
+         }();
+
+         static constexpr std::array<std::size_t, sizeof...(Ts)> offsets = [] {
+            auto result = std::array<std::size_t, sizeof...(Ts)>{};
+            auto const alignments = std::array<std::size_t, sizeof...(Ts)>{
+               block_member<L, Ts>::alignment...};
+            auto const sizes = std::array<std::size_t, sizeof...(Ts)>{block_member<L, Ts>::size...};
+            auto end = std::size_t{0};
+            for (auto i = std::size_t{0}; i < sizeof...(Ts); ++i) {
+               result[i] = round_up(end, alignments[i]);
+               end = result[i] + sizes[i];
+            }
+            return result;
+         }();
+
+         static constexpr std::size_t size = [] {
+            auto end = std::size_t{0};
+            auto const sizes = std::array<std::size_t, sizeof...(Ts)>{block_member<L, Ts>::size...};
+            for (auto i = std::size_t{0}; i < sizeof...(Ts); ++i)
+               end = offsets[i] + sizes[i];
+            return round_up(end, alignment);
+         }();
+      };
+   } // namespace detail
+
+   template <basic_buffer_type Target, typename Tuple, block_layout Layout>
+   class basic_block;
+
+   /// @brief A buffer-backed interface block, whose members are the types of a std_layout_tuple.
+   ///
+   /// The offsets of the members are computed at compile time using Layout's rules, so the values
+   /// are packed into the GLSL layout on the CPU and uploaded with a single call. A block is shared
+   /// between programs by attaching each of them to the same binding point:
+   ///
+   ///    auto camera = doge::uniform_block<doge::std_layout_tuple<doge::mat4, doge::mat4>>{0};
+   ///    camera.attach(cube.program(), "camera");
+   ///    camera.attach(lamp.program(), "camera");
+   ///    camera.write({view, projection}); // once per frame, for every program
+   ///
+   /// @note Supported member types are GLfloat, GLint, GLuint, GLdouble, bool, glm vectors and
+   ///    matrices of those, and std::arrays of all of the above.
+   ///
+   template <basic_buffer_type Target, typename... Ts, block_layout Layout>
+   requires
+      (Target == basic_buffer_type::uniform || Target == basic_buffer_type::shader_storage) &&
+      not (Target == basic_buffer_type::uniform && Layout == block_layout::std430)
+   class basic_block<Target, std_layout_tuple<Ts...>, Layout> {
+      using members = detail::block_members<Layout, Ts...>;
+   public:
+      using value_type = std_layout_tuple<Ts...>;
+
+      /// @brief The offset of each member in the block, in bytes.
+      ///
+      static constexpr auto offsets = members::offsets;
+
+      /// @brief The size of the block, in bytes.
+      ///
+      static constexpr auto size = members::size;
+
+      /// @param binding The binding point that the block is bound to, and that programs are attached
+      ///    to.
+      ///
+      explicit basic_block(GLuint const binding,
+         basic_buffer_usage const usage = basic_buffer_usage::dynamic_draw) noexcept
+         : binding_{binding}
+      {
+         if (direct_state_access::enabled()) {
+            gl::NamedBufferData(*buffer_, size, nullptr, static_cast<GLenum>(usage));
+         }
+         else {
+            constexpr auto target = static_cast<GLenum>(Target);
+            state_cache::bind_buffer(target, *buffer_);
+            gl::BufferData(target, size, nullptr, static_cast<GLenum>(usage));
+         }
+
+         bind();
+      }
+
+      basic_block(GLuint const binding, value_type const& values,
+         basic_buffer_usage const usage = basic_buffer_usage::dynamic_draw) noexcept
+         : basic_block{binding, usage}
+      {
+         write(values);
+      }
+
+      /// @brief Replaces the block's contents with values.
+      ///
+      void write(value_type const& values) noexcept
+      {
+         auto staging = std::array<std::byte, size>{};
+         pack(staging, values, std::index_sequence_for<Ts...>{});
+
+         if (direct_state_access::enabled()) {
+            gl::NamedBufferSubData(*buffer_, 0, size, ranges::data(staging));
+            return;
+         }
+
+         constexpr auto target = static_cast<GLenum>(Target);
+         state_cache::bind_buffer(target, *buffer_);
+         gl::BufferSubData(target, 0, size, ranges::data(staging));
+      }
+
+      /// @brief Binds the block to its binding point. This only needs to be done again if something
+      ///    else has been bound there since.
+      ///
+      void bind() const noexcept
+      {
+         state_cache::bind_buffer_base(static_cast<GLenum>(Target), binding_, *buffer_);
+      }
+
+      /// @brief Points program's block called name at this block's binding point.
+      /// @throws std::runtime_error if program doesn't have an active block called name, or if that
+      ///    block needs more space than this block has.
+      ///
+      void attach(shader_binary const& program, resource_name const name) const
+      {
+         auto const* const block = Target == basic_buffer_type::uniform
+                                 ? program.reflection().uniform_block(name)
+                                 : program.reflection().storage_block(name);
+         if (block == nullptr)
+            throw std::runtime_error{"block not found: " + std::string{name.name()}};
+
+         if (static_cast<std::size_t>(block->data_size) > size) {
+            throw std::runtime_error{"block " + std::string{name.name()} + " needs "
+               + std::to_string(block->data_size) + " bytes, but only has " + std::to_string(size)};
+         }
+
+         if constexpr (Target == basic_buffer_type::uniform)
+            gl::UniformBlockBinding(static_cast<GLuint>(program), block->index, binding_);
+         else
+            gl::ShaderStorageBlockBinding(static_cast<GLuint>(program), block->index, binding_);
+      }
+
+      [[nodiscard]] GLuint binding() const noexcept
+      {
+         return binding_;
+      }
+
+      [[nodiscard]] GLuint get() const noexcept
+      {
+         return *buffer_;
+      }
+   private:
+      gpu_ptr<resource_type::buffer> buffer_;
+      GLuint binding_;
+
+      template <std::size_t... I>
+      static void pack(std::array<std::byte, size>& out, value_type const& values,
+         std::index_sequence<I...>) noexcept
+      {
+         (detail::block_member<Layout, Ts>::pack(ranges::data(out) + offsets[I],
+            doge::get<I>(values)), ...);
+      }
+   };
+
+   template <typename Tuple, block_layout Layout = block_layout::std140>
+   using uniform_block = basic_block<basic_buffer_type::uniform, Tuple, Layout>;
+
+   template <typename Tuple, block_layout Layout = block_layout::std430>
+   using storage_block = basic_block<basic_buffer_type::shader_storage, Tuple, Layout>;
+} // namespace doge
+
+#endif // DOGE_GL_UNIFORM_BLOCK_HPP
@@ -0,0 +1,124 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_GL_UNIFORM_UPLOADS_HPP
+#define DOGE_GL_UNIFORM_UPLOADS_HPP
+
+#include <doge/gl/state_cache.hpp>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/iterator>
+#include <gl/gl_core.hpp>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief Determines when assigning to a uniform reaches the GPU.
+   ///
+   enum class uniform_upload {
+      /// @brief Every assignment is uploaded as it happens.
+      immediate,
+
+      /// @brief Assignments only mark the uniform as dirty. Dirty uniforms are uploaded once, just
+      ///    before their program's next draw, so intermediate values are never uploaded.
+      deferred
+   };
+
+   /// @brief Tracks the uniforms that have changed since their program last drew.
+   ///
+   /// doge's draw calls flush the current program's uniforms themselves. Code that draws by calling
+   /// GL directly must call uniform_uploads::flush() first.
+   ///
+   class uniform_uploads {
+   public:
+      /// @brief Changes the upload mode. Switching to immediate uploads everything that's pending.
+      ///
+      static void mode(uniform_upload const m)
+      {
+         if (m == uniform_upload::immediate)
+            flush_all();
+         mode_ = m;
+      }
+
+      [[nodiscard]] static uniform_upload mode() noexcept
+      {
+         return mode_;
+      }
+
+      /// @brief Uploads the dirty uniforms that belong to the current program.
+      ///
+      static void flush()
+      {
+         if (ranges::empty(pending_))
+            return;
+         flush(state_cache::program());
+      }
+
+      /// @brief Uploads the dirty uniforms that belong to program, which must be current.
+      ///
+      static void flush(GLuint const program)
+      {
+         auto const first = ranges::remove_if(pending_, [program](pending const& p) {
+            if (p.program != program)
+               return false;
+
+            p.upload(p.uniform);
+            return true;
+         });
+         pending_.erase(first, ranges::end(pending_));
+      }
+
+      /// @brief Records that uniform needs to be uploaded before program next draws.
+      /// @param upload Uploads uniform and clears its dirty flag.
+      ///
+      static void mark(GLuint const program, void* const uniform, void (*upload)(void*))
+      {
+         pending_.push_back({program, uniform, upload});
+      }
+
+      /// @brief Drops uniform's pending upload, if it has one.
+      ///
+      static void forget(void const* const uniform) noexcept
+      {
+         auto const first = ranges::remove_if(pending_, [uniform](pending const& p) {
+            return p.uniform == uniform;
+         });
+         pending_.erase(first, ranges::end(pending_));
+      }
+   private:
+      struct pending {
+         GLuint program;
+         void* uniform;
+         void (*upload)(void*);
+      };
+
+      static inline uniform_upload mode_ = uniform_upload::immediate;
+      static inline std::vector<pending> pending_;
+
+      static void flush_all()
+      {
+         auto const previous = state_cache::program();
+         while (not ranges::empty(pending_)) {
+            auto const program = pending_.front().program;
+            state_cache::use_program(program);
+            flush(program);
+         }
+         state_cache::use_program(previous);
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_GL_UNIFORM_UPLOADS_HPP
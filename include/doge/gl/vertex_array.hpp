@@ -17,16 +17,23 @@
 #define DOGE_GL_VERTEX_ARRAY_HPP
 
 #include "doge/gl/buffer.hpp"
+#include "doge/gl/direct_state_access.hpp"
 #include "doge/gl/memory.hpp"
-#include "doge/meta/clear.hpp"
-#include "doge/meta/partial_sum.hpp"
-#include "doge/meta/rotate.hpp"
+#include "doge/gl/packed_attributes.hpp"
+#include "doge/gl/render_queue.hpp"
+#include "doge/gl/state_cache.hpp"
+#include "doge/gl/uniform_uploads.hpp"
+#include "doge/utility/mesh_optimisation.hpp"
 #include "doge/utility/std_layout_tuple.hpp"
 #include "doge/utility/type_traits.hpp"
+#include <array>
+#include <cstddef>
 #include <experimental/ranges/concepts>
 #include "gl/gl_core.hpp"
+#include <glm/fwd.hpp>
 #include <gsl/gsl>
 #include <functional>
+#include <utility>
 
 #pragma GCC diagnostic push 
 #pragma GCC diagnostic ignored "-Wsign-compare"
@@ -34,10 +41,193 @@
 #pragma GCC diagnostic pop
 
 namespace doge {
+   namespace detail {
+      /// @brief How an attribute of type T is laid out: the number of consecutive locations that it
+      ///    fills, the number of components in each, how those components are stored, and whether
+      ///    integers are normalised to [0, 1] or [-1, 1] when they're read.
+      ///
+      template <typename T>
+      struct attribute_traits {
+         static constexpr GLuint locations = 1;
+         static constexpr GLint components = sizeof(T) / sizeof(underlying_type_t<T>);
+         static constexpr GLenum type = glsl_type_v<underlying_type_t<T>>;
+         static constexpr bool normalised = false;
+      };
+
+      // A matrix fills one location per column.
+      template <glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+      struct attribute_traits<glm::mat<C, R, T, Q>> {
+         static constexpr GLuint locations = C;
+         static constexpr GLint components = R;
+         static constexpr GLenum type = glsl_type_v<T>;
+         static constexpr bool normalised = false;
+      };
+
+      template <glm::length_t L>
+      struct attribute_traits<half_vec<L>> {
+         static constexpr GLuint locations = 1;
+         static constexpr GLint components = L;
+         static constexpr GLenum type = gl::HALF_FLOAT;
+         static constexpr bool normalised = false;
+      };
+
+      template <glm::length_t L>
+      struct attribute_traits<unorm8_vec<L>> {
+         static constexpr GLuint locations = 1;
+         static constexpr GLint components = L;
+         static constexpr GLenum type = gl::UNSIGNED_BYTE;
+         static constexpr bool normalised = true;
+      };
+
+      template <>
+      struct attribute_traits<snorm_10_10_10_2> {
+         static constexpr GLuint locations = 1;
+         static constexpr GLint components = 4;
+         static constexpr GLenum type = gl::INT_2_10_10_10_REV;
+         static constexpr bool normalised = true;
+      };
+
+      /// @brief Describes how a vertex array reads std_layout_tuple<Ts...>s from a buffer: the
+      ///    members fill consecutive locations, in order, and are all sourced from the same buffer.
+      ///
+      template <typename... Ts>
+      requires
+         (StandardLayout<Ts> && ...) &&
+         ((attribute_traits<Ts>::components <= 4) && ...)
+      struct vertex_format {
+         /// @brief The number of locations that the format fills.
+         ///
+         static constexpr GLuint locations = (attribute_traits<Ts>::locations + ...);
+
+         /// @brief Points vertex_array's attributes at buffer, which holds the vertices from its
+         ///    first byte onward.
+         /// @param first_location The location of the first member.
+         /// @param divisor 0 to advance once per vertex, or n to advance once every n instances.
+         /// @param binding The buffer binding index that the attributes are sourced from, when
+         ///    direct state access is enabled.
+         /// @note Without direct state access, this leaves vertex_array bound.
+         ///
+         static void attach(GLuint const vertex_array, GLuint const buffer,
+            GLuint const first_location = 0, GLuint const divisor = 0,
+            GLuint const binding = 0) noexcept
+         {
+            constexpr auto stride = GLsizei{(sizeof(Ts) + ...)};
+            if (direct_state_access::enabled()) {
+               gl::VertexArrayVertexBuffer(vertex_array, binding, buffer, 0, stride);
+               gl::VertexArrayBindingDivisor(vertex_array, binding, divisor);
+               for_each_location(first_location, [vertex_array, binding](GLuint const location,
+                  GLint const components, GLenum const type, bool const normalised,
+                  std::size_t const offset) {
+                  gl::VertexArrayAttribFormat(vertex_array, location, components, type, normalised,
+                     gsl::narrow_cast<GLuint>(offset));
+                  gl::VertexArrayAttribBinding(vertex_array, location, binding);
+                  gl::EnableVertexArrayAttrib(vertex_array, location);
+               });
+               return;
+            }
+
+            state_cache::bind_vertex_array(vertex_array);
+            state_cache::bind_buffer(gl::ARRAY_BUFFER, buffer);
+            for_each_location(first_location, [divisor](GLuint const location,
+               GLint const components, GLenum const type, bool const normalised,
+               std::size_t const offset) {
+               gl::VertexAttribPointer(location, components, type, normalised, stride,
+                  reinterpret_cast<void const*>(offset));
+               gl::VertexAttribDivisor(location, divisor);
+               gl::EnableVertexAttribArray(location);
+            });
+         }
+      private:
+         // Calls f with the location, component count, component type, normalisation, and byte
+         // offset of each location that the format fills.
+         template <typename F>
+         static void for_each_location(GLuint location, F const& f) noexcept
+         {
+            auto offset = std::size_t{0};
+            ([&location, &offset, &f]{
+               using traits = attribute_traits<Ts>;
+               for (auto i = GLuint{0}; i < traits::locations; ++i) {
+                  f(location++, traits::components, traits::type, traits::normalised,
+                     offset + i * (sizeof(Ts) / traits::locations));
+               }
+               offset += sizeof(Ts);
+            }(), ...);
+         }
+      };
+
+      // The direct state access binding index that instance attributes are sourced from. It's the
+      // last of the sixteen that every implementation has, so that vertex streams can use the
+      // bindings below it.
+      inline constexpr auto instance_binding = GLuint{15};
+   } // namespace detail
+
+   /// @brief Attributes that advance once per instance rather than once per vertex, such as each
+   ///    instance's model matrix.
+   ///
+   /// An instance_buffer is attached to a vertex array, after the vertex attributes, and then every
+   /// instanced draw of that vertex array reads from it:
+   ///
+   ///    auto models = doge::instance_buffer<doge::basic_buffer_usage::dynamic_draw, doge::mat4>{};
+   ///    models.write(transforms);
+   ///    props.attach(models);                            // locations 3 to 6 for a 3-attribute mesh
+   ///    props.draw_instanced(models.size(), []{});
+   ///
    template <basic_buffer_usage Usage, typename... Ts>
    requires
       (StandardLayout<Ts> && ...) &&
-      ((sizeof(Ts) / sizeof(underlying_type_t<Ts>) <= 4) && ...)
+      ((detail::attribute_traits<Ts>::components <= 4) && ...)
+   class instance_buffer {
+   public:
+      using value_type = std_layout_tuple<Ts...>;
+
+      instance_buffer() = default;
+
+      explicit instance_buffer(gsl::span<value_type const> const data) noexcept
+      {
+         write(data);
+      }
+
+      /// @brief Replaces every instance.
+      ///
+      void write(gsl::span<value_type const> const data) noexcept
+      {
+         vbo_.write(data);
+         count_ = gsl::narrow_cast<GLsizei>(ranges::size(data));
+      }
+
+      /// @brief Replaces the instances starting at index first. The new instances reach the GPU
+      ///    when flush() is called.
+      ///
+      void write(std::size_t const first, gsl::span<value_type const> const data)
+      {
+         vbo_.write(first, data);
+      }
+
+      void flush() noexcept
+      {
+         vbo_.flush();
+      }
+
+      /// @brief The number of instances that were last written.
+      ///
+      [[nodiscard]] GLsizei size() const noexcept
+      {
+         return count_;
+      }
+
+      [[nodiscard]] GLuint get() const noexcept
+      {
+         return vbo_.get()[0];
+      }
+   private:
+      array_buffer<Usage, Ts...> vbo_;
+      GLsizei count_ = 0;
+   };
+
+   template <basic_buffer_usage Usage, typename... Ts>
+   requires
+      (StandardLayout<Ts> && ...) &&
+      ((detail::attribute_traits<Ts>::components <= 4) && ...)
    class vertex_array_buffer {
    public:
       explicit vertex_array_buffer(gsl::span<std_layout_tuple<Ts...> const> const data) noexcept
@@ -50,22 +240,85 @@ namespace doge {
          write(data, []{});
       }
 
+      /// @brief Replaces the vertices starting at index first. The new vertices reach the GPU the
+      ///    next time that the buffer is drawn or flushed.
+      ///
+      void write(std::size_t const first, gsl::span<std_layout_tuple<Ts...> const> const data)
+      {
+         vbo_.write(first, data);
+      }
+
+      /// @brief Uploads the vertices that have been partially written since the last flush.
+      ///
+      void flush() noexcept
+      {
+         vbo_.flush();
+      }
+
       template <ranges::Invocable F>
       void bind(F const& f) const noexcept(noexcept(std::is_nothrow_invocable_v<F>))
       {
-         gl::BindVertexArray(*vao_);
+         state_cache::bind_vertex_array(*vao_);
          ranges::invoke(f);
-         gl::BindVertexArray(0);
       }
 
       template <ranges::Invocable F>
-      void draw(F const& f) const noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      void draw(F const& f) noexcept(noexcept(std::is_nothrow_invocable_v<F>))
       {
+         flush();
          bind([this, f]{
             ranges::invoke(f);
+            uniform_uploads::flush();
             gl::DrawArrays(gl::TRIANGLES, 0, count_);
          });
       }
+
+      /// @brief Sources the per-instance attributes from instances. Their locations follow the
+      ///    vertex attributes', so a mesh with three vertex attributes reads its first instance
+      ///    attribute from location 3.
+      ///
+      template <basic_buffer_usage InstanceUsage, typename... Is>
+      void attach(instance_buffer<InstanceUsage, Is...> const& instances) noexcept
+      {
+         detail::vertex_format<Is...>::attach(*vao_, instances.get(),
+            detail::vertex_format<Ts...>::locations, 1, detail::instance_binding);
+      }
+
+      /// @brief Draws the mesh instances times, with a single call.
+      /// @note The attached instance_buffer must have been flushed, if it's been partially written.
+      ///
+      template <ranges::Invocable F>
+      void draw_instanced(GLsizei const instances, F const& f) noexcept(noexcept(
+         std::is_nothrow_invocable_v<F>))
+      {
+         flush();
+         bind([this, instances, f]{
+            ranges::invoke(f);
+            uniform_uploads::flush();
+            gl::DrawArraysInstanced(gl::TRIANGLES, 0, count_, instances);
+         });
+      }
+
+      /// @brief Describes what draw() issues, so that it can be submitted to a render_queue.
+      /// @note flush() must be called before the queue is flushed, if the buffer has been partially
+      ///    written.
+      ///
+      [[nodiscard]] draw_call as_draw_call() const noexcept
+      {
+         auto result = draw_call{};
+         result.vertex_array = *vao_;
+         result.count = count_;
+         return result;
+      }
+
+      /// @brief Describes what draw_instanced(instances, f) issues.
+      ///
+      [[nodiscard]] draw_call as_draw_call(GLsizei const instances) const noexcept
+      {
+         auto result = as_draw_call();
+         result.instances = instances;
+         return result;
+      }
    protected:
       GLsizei count() const noexcept
       {
@@ -77,35 +330,27 @@ namespace doge {
          count_ = c;
       }
 
+      GLuint vertex_array() const noexcept
+      {
+         return *vao_;
+      }
+
       template <ranges::Invocable F>
       void write(gsl::span<std_layout_tuple<Ts...> const> const data, F const& f) noexcept(noexcept(
          std::is_nothrow_invocable_v<F>))
       {
          vbo_.write(data);
-         bind([this, data, f]{
-            count_ = ranges::size(data);
-            f();
-            vertex_attrib_pointer(std::index_sequence_for<Ts...>{},
-               meta::clear_t<0, meta::rotate_t<sizeof...(Ts) - 1, meta::partial_sum_t<(sizeof(Ts) / sizeof(underlying_type_t<Ts>))...>>>{});
-          });
+         count_ = ranges::size(data);
+         detail::vertex_format<Ts...>::attach(*vao_, vbo_.get()[0]);
+         if (direct_state_access::enabled())
+            ranges::invoke(f);
+         else
+            bind(f);
       }
    private:
       GLsizei count_ = 0;
       array_buffer<Usage, Ts...> vbo_;
       gpu_ptr<resource_type::vertex_array> vao_;
-
-      template <std::size_t... Index, std::size_t... Offset>
-      void vertex_attrib_pointer(std::index_sequence<Index...>, std::index_sequence<Offset...>)
-      {
-         (gl::DisableVertexAttribArray(Index), ...);
-         (gl::VertexAttribPointer(Index,                                            // index
-            sizeof(Ts) / sizeof(underlying_type_t<Ts>),                             // size
-            glsl_type_v<Ts>,                                                        // type
-            false,                                                                  // normalised
-            (sizeof(Ts) + ...),                                                     // stride
-            reinterpret_cast<void const*>(Offset * sizeof(glsl_type_t<Ts>))), ...); // offset
-         (gl::EnableVertexAttribArray(Index), ...);
-      }
    };
 
    template <basic_buffer_usage Usage = basic_buffer_usage::static_draw, typename... Ts>
@@ -132,12 +377,162 @@ namespace doge {
       return vertex_array_buffer<Usage, Ts...>{data};
    }
 
+   /// @brief A vertex array whose attributes are each kept in a stream of their own, rather than
+   ///    interleaved, so that one attribute can be rewritten without uploading the others.
+   ///
+   ///    auto mesh = doge::vertex_stream_buffer<doge::basic_buffer_usage::dynamic_draw,
+   ///       doge::vec3, doge::vec3, doge::vec2>{positions, normals, uvs};
+   ///    mesh.write<0>(animated_positions);   // the normals and uvs stay where they are
+   ///
    template <basic_buffer_usage Usage, typename... Ts>
    requires
       (StandardLayout<Ts> && ...) &&
-      ((sizeof(Ts) / sizeof(underlying_type_t<Ts>) <= 4) && ...)
+      ((detail::attribute_traits<Ts>::components <= 4) && ...)
+   class vertex_stream_buffer {
+      using buffer_type = basic_buffer<resource_type::buffer, basic_buffer_type::array, Usage,
+         basic_buffer_layout::structure_of_arrays, Ts...>;
+   public:
+      template <std::size_t I>
+      using stream_type = typename buffer_type::template stream_type<I>;
+
+      /// @param streams The values of each attribute, which must all have the same size.
+      ///
+      template <typename... Ranges>
+      requires
+         sizeof...(Ts) == sizeof...(Ranges) &&
+         (ranges::ext::ContiguousRange<Ranges> && ...)
+      explicit vertex_stream_buffer(Ranges const&... streams) noexcept
+      {
+         write(streams...);
+         attach_streams(std::index_sequence_for<Ts...>{});
+      }
+
+      /// @brief Replaces every stream.
+      ///
+      template <typename... Ranges>
+      requires
+         sizeof...(Ts) == sizeof...(Ranges) &&
+         (ranges::ext::ContiguousRange<Ranges> && ...)
+      void write(Ranges const&... streams) noexcept
+      {
+         Expects(((ranges::size(streams) == ranges::size(first_of(streams...))) && ...));
+         streams_.write(streams...);
+         count_ = gsl::narrow_cast<GLsizei>(ranges::size(first_of(streams...)));
+      }
+
+      /// @brief Replaces stream I, which must keep the same number of vertices.
+      ///
+      template <std::size_t I>
+      void write(gsl::span<stream_type<I> const> const data) noexcept
+      {
+         Expects(gsl::narrow_cast<GLsizei>(ranges::size(data)) == count_);
+         streams_.template write<I>(data);
+      }
+
+      /// @brief Replaces the values of stream I starting at index first, straight away.
+      ///
+      template <std::size_t I>
+      void write(std::size_t const first, gsl::span<stream_type<I> const> const data) noexcept
+      {
+         streams_.template write<I>(first, data);
+      }
+
+      template <ranges::Invocable F>
+      void bind(F const& f) const noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      {
+         state_cache::bind_vertex_array(*vao_);
+         ranges::invoke(f);
+      }
+
+      template <ranges::Invocable F>
+      void draw(F const& f) const noexcept(noexcept(std::is_nothrow_invocable_v<F>))
+      {
+         bind([this, f]{
+            ranges::invoke(f);
+            uniform_uploads::flush();
+            gl::DrawArrays(gl::TRIANGLES, 0, count_);
+         });
+      }
+
+      /// @copydoc vertex_array_buffer::attach
+      ///
+      template <basic_buffer_usage InstanceUsage, typename... Is>
+      void attach(instance_buffer<InstanceUsage, Is...> const& instances) noexcept
+      {
+         detail::vertex_format<Is...>::attach(*vao_, instances.get(),
+            detail::vertex_format<Ts...>::locations, 1, detail::instance_binding);
+      }
+
+      /// @copydoc vertex_array_buffer::draw_instanced
+      ///
+      template <ranges::Invocable F>
+      void draw_instanced(GLsizei const instances, F const& f) const noexcept(noexcept(
+         std::is_nothrow_invocable_v<F>))
+      {
+         bind([this, instances, f]{
+            ranges::invoke(f);
+            uniform_uploads::flush();
+            gl::DrawArraysInstanced(gl::TRIANGLES, 0, count_, instances);
+         });
+      }
+
+      /// @copydoc vertex_array_buffer::as_draw_call
+      ///
+      [[nodiscard]] draw_call as_draw_call() const noexcept
+      {
+         auto result = draw_call{};
+         result.vertex_array = *vao_;
+         result.count = count_;
+         return result;
+      }
+
+      /// @copydoc vertex_array_buffer::as_draw_call(GLsizei)
+      ///
+      [[nodiscard]] draw_call as_draw_call(GLsizei const instances) const noexcept
+      {
+         auto result = as_draw_call();
+         result.instances = instances;
+         return result;
+      }
+
+      /// @brief The number of vertices.
+      ///
+      [[nodiscard]] GLsizei size() const noexcept
+      {
+         return count_;
+      }
+   private:
+      GLsizei count_ = 0;
+      buffer_type streams_;
+      gpu_ptr<resource_type::vertex_array> vao_;
+
+      template <typename Range, typename... Ranges>
+      static Range const& first_of(Range const& range, Ranges const&...) noexcept
+      {
+         return range;
+      }
+
+      // Stream I feeds the locations that follow the ones before it, from binding I. The streams'
+      // names never change, since a full write reallocates their storage in place, so this only
+      // needs to happen once.
+      template <std::size_t... I>
+      void attach_streams(std::index_sequence<I...>) noexcept
+      {
+         constexpr auto counts = std::array<GLuint, sizeof...(Ts)>{
+            detail::attribute_traits<Ts>::locations...};
+         auto location = GLuint{0};
+         ((detail::vertex_format<Ts>::attach(*vao_, streams_[I], location, 0, I),
+           location += counts[I]), ...);
+      }
+   };
+
+   template <basic_buffer_usage Usage, typename... Ts>
+   requires
+      (StandardLayout<Ts> && ...) &&
+      ((detail::attribute_traits<Ts>::components <= 4) && ...)
    class vertex_element_buffer : vertex_array_buffer<Usage, Ts...> {
    public:
+      using vertex_array_buffer<Usage, Ts...>::attach;
       using vertex_array_buffer<Usage, Ts...>::bind;
 
       explicit vertex_element_buffer(gsl::span<std_layout_tuple<Ts...> const> const data,
@@ -155,22 +550,103 @@ namespace doge {
          });
       }
 
+      /// @copydoc vertex_array_buffer::write(std::size_t, gsl::span<std_layout_tuple<Ts...> const>)
+      ///
+      void write(std::size_t const first, gsl::span<std_layout_tuple<Ts...> const> const data)
+      {
+         vertex_array_buffer<Usage, Ts...>::write(first, data);
+      }
+
+      /// @brief Replaces the elements starting at index first. The new elements reach the GPU the
+      ///    next time that the buffer is drawn or flushed.
+      ///
+      void write(std::size_t const first, gsl::span<GLuint const> const elements)
+      {
+         ebo_.write(first, elements);
+      }
+
+      /// @brief Uploads the vertices and elements that have been partially written since the last
+      ///    flush.
+      ///
+      void flush() noexcept
+      {
+         vertex_array_buffer<Usage, Ts...>::flush();
+         ebo_.flush();
+      }
+
       template <ranges::Invocable F>
       void draw(F const& f) noexcept(noexcept(std::is_nothrow_invocable_v<F>))
       {
+         flush();
          bind([this, f]{
             ranges::invoke(f);
-            gl::DrawElements(gl::TRIANGLES, this->count(), gl::UNSIGNED_INT, nullptr);
+            uniform_uploads::flush();
+            gl::DrawElements(gl::TRIANGLES, this->count(), ebo_.index_type(), nullptr);
+         });
+      }
+
+      /// @copydoc vertex_array_buffer::draw_instanced
+      ///
+      template <ranges::Invocable F>
+      void draw_instanced(GLsizei const instances, F const& f) noexcept(noexcept(
+         std::is_nothrow_invocable_v<F>))
+      {
+         flush();
+         bind([this, instances, f]{
+            ranges::invoke(f);
+            uniform_uploads::flush();
+            gl::DrawElementsInstanced(gl::TRIANGLES, this->count(), ebo_.index_type(), nullptr,
+               instances);
          });
       }
+
+      /// @copydoc vertex_array_buffer::as_draw_call
+      ///
+      [[nodiscard]] draw_call as_draw_call() const noexcept
+      {
+         auto result = vertex_array_buffer<Usage, Ts...>::as_draw_call();
+         result.index_type = ebo_.index_type();
+         return result;
+      }
+
+      /// @copydoc vertex_array_buffer::as_draw_call(GLsizei)
+      ///
+      [[nodiscard]] draw_call as_draw_call(GLsizei const instances) const noexcept
+      {
+         auto result = as_draw_call();
+         result.instances = instances;
+         return result;
+      }
+
+      /// @brief Describes a draw of one level of detail, when the buffer holds a lod_mesh.
+      ///
+      [[nodiscard]] draw_call as_draw_call(mesh_lod const& lod, GLsizei const instances = 1) const
+         noexcept
+      {
+         Expects(lod.first + lod.count <= gsl::narrow_cast<std::size_t>(this->count()));
+         auto result = as_draw_call(instances);
+         result.count = gsl::narrow_cast<GLsizei>(lod.count);
+         result.first = gsl::narrow_cast<GLintptr>(lod.first
+            * detail::index_size(ebo_.index_type()));
+         return result;
+      }
    private:
       element_array_buffer<Usage> ebo_;
 
       void write(gsl::span<GLuint const> const elements) noexcept
       {
+         if (direct_state_access::enabled()) {
+            this->count(ranges::size(elements));
+            ebo_.write(elements);
+            gl::VertexArrayElementBuffer(this->vertex_array(), ebo_.get()[0]);
+            return;
+         }
+
+         // ebo_ uploads through GL_COPY_WRITE_BUFFER, so it's attached to the vertex array here.
          bind([this, elements]{
             this->count(ranges::size(elements));
             ebo_.write(elements);
+            state_cache::bind_buffer(gl::ELEMENT_ARRAY_BUFFER, ebo_.get()[0]);
          });
       }
    };
@@ -199,6 +675,23 @@ namespace doge {
    {
       return vertex_element_buffer<Usage, Ts...>{data, elements};
    }
+
+   /// @brief Uploads a mesh that optimise_mesh() has produced.
+   ///
+   template <basic_buffer_usage Usage = basic_buffer_usage::static_draw, typename... Ts>
+   auto make_vertex_element_buffer(indexed_mesh<Ts...> const& mesh) noexcept
+   {
+      return vertex_element_buffer<Usage, Ts...>{mesh.vertices, mesh.elements};
+   }
+
+   /// @brief Uploads every level of a mesh that make_lods() has produced. Each level is drawn with
+   ///    as_draw_call(mesh.lods[i]).
+   ///
+   template <basic_buffer_usage Usage = basic_buffer_usage::static_draw, typename... Ts>
+   auto make_vertex_element_buffer(lod_mesh<Ts...> const& mesh) noexcept
+   {
+      return vertex_element_buffer<Usage, Ts...>{mesh.vertices, mesh.elements};
+   }
 } // namespace doge
 
 #endif // DOGE_GL_VERTEX_ARRAY_HPP
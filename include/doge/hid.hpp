@@ -16,6 +16,7 @@
 #ifndef DOGE_HID_HPP
 #define DOGE_HID_HPP
 
+#include <cstdint>
 #include <experimental/ranges/concepts>
 #include <functional>
 #include <gl/gl_core.hpp>
@@ -26,8 +27,45 @@ namespace doge::hid {
    enum class key_state { up, release, press, down };
    using std::experimental::ranges::Regular;
 
+   /// @brief A single input event, as reported by GLFW.
+   ///
+   struct input_event {
+      enum class device : std::uint8_t { keyboard, mouse_button, cursor, scroll };
+
+      device source = device::keyboard;
+      int code = 0;   ///< The key or mouse button.
+      int action = 0; ///< GLFW_PRESS, GLFW_RELEASE, or GLFW_REPEAT.
+      int mods = 0;
+      glm::vec2 position = {0.0f, 0.0f}; ///< The cursor position, or the scroll offset.
+   };
+
    class hid {
    public:
+      using observer = void (*)(input_event const&, void*) noexcept;
+
+      /// @brief Registers o to be invoked with every event that GLFW reports, before the event is
+      ///    applied. Passing nullptr removes the observer.
+      /// @param context Passed through to o unchanged.
+      ///
+      static void observe(observer const o, void* const context = nullptr) noexcept
+      {
+         observer_ = o;
+         observer_context_ = context;
+      }
+
+      /// @brief Toggles whether events from GLFW are applied. When input is being replayed, live
+      ///    input is ignored so that it can't interfere with the replay.
+      ///
+      static void live(bool const l) noexcept
+      {
+         live_ = l;
+      }
+
+      static bool live() noexcept
+      {
+         return live_;
+      }
+
       static bool shift() noexcept
       {
          return shift_;
@@ -48,6 +86,16 @@ namespace doge::hid {
          return super_;
       }
    protected:
+      static bool accept(input_event const& e) noexcept
+      {
+         if (not live_)
+            return false;
+
+         if (observer_ != nullptr)
+            observer_(e, observer_context_);
+         return true;
+      }
+
       static void modifiers(const int mods) noexcept
       {
          shift_ = mods & GLFW_MOD_SHIFT;
@@ -62,6 +110,9 @@ namespace doge::hid {
       static inline Regular control_ = false;
       static inline Regular alt_ = false;
       static inline Regular super_ = false;
+      static inline Regular live_ = true;
+      static inline observer observer_ = nullptr;
+      static inline void* observer_context_ = nullptr;
    };
 
    class keyboard : public hid {
@@ -81,18 +132,35 @@ namespace doge::hid {
       {
          key_mask_.at(i + 1) = s;
       }
-   private:
-      static inline Regular key_mask_ = std::vector(360, key_state::up);
 
-      static void callback(GLFWwindow*, int key, int, int action, int mods) noexcept
+      /// @brief Whether i is a key that the keyboard keeps track of, including GLFW_KEY_UNKNOWN.
+      ///
+      static bool valid_key(const int i) noexcept
       {
-         ++key;
-         if (action == GLFW_PRESS && key_mask_[key] != key_state::down)
+         return i >= -1 && i + 1 < static_cast<int>(key_mask_.size());
+      }
+
+      /// @brief Updates the keyboard state as if GLFW had reported e.
+      /// @pre valid_key(e.code)
+      ///
+      static void apply(input_event const& e) noexcept
+      {
+         auto const key = e.code + 1;
+         if (e.action == GLFW_PRESS && key_mask_[key] != key_state::down)
             key_mask_[key] = key_state::press;
-         else if (action == GLFW_RELEASE && key_mask_[key] != key_state::up)
+         else if (e.action == GLFW_RELEASE && key_mask_[key] != key_state::up)
             key_mask_[key] = key_state::release;
 
-         modifiers(mods);
+         modifiers(e.mods);
+      }
+   private:
+      static inline Regular key_mask_ = std::vector(360, key_state::up);
+
+      static void callback(GLFWwindow*, int key, int, int action, int mods) noexcept
+      {
+         auto const e = input_event{input_event::device::keyboard, key, action, mods};
+         if (accept(e))
+            apply(e);
       }
    };
 
@@ -177,6 +245,40 @@ namespace doge::hid {
          scroll_[previous] = scroll_[current];
       }
 
+      /// @brief Whether i is a mouse button that the mouse keeps track of.
+      ///
+      static bool valid_button(const int i) noexcept
+      {
+         return i >= 0 && i < static_cast<int>(key_mask_.size());
+      }
+
+      /// @brief Updates the mouse state as if GLFW had reported e.
+      /// @pre valid_button(e.code) if e is a mouse button event.
+      ///
+      static void apply(input_event const& e) noexcept
+      {
+         switch (e.source) {
+         case input_event::device::mouse_button:
+            if (e.action == GLFW_PRESS && key_mask_[e.code] != key_state::down)
+               key_mask_[e.code] = key_state::press;
+            else if (e.action == GLFW_RELEASE && key_mask_[e.code] != key_state::up)
+               key_mask_[e.code] = key_state::release;
+
+            modifiers(e.mods);
+            break;
+         case input_event::device::cursor:
+            cursor_[previous] = cursor_[current];
+            cursor_[current] = e.position;
+            break;
+         case input_event::device::scroll:
+            scroll_[previous] = scroll_[current];
+            scroll_[current] = e.position;
+            break;
+         case input_event::device::keyboard:
+            break;
+         }
+      }
+
       template <typename F, typename... Args>
       requires
          std::experimental::ranges::Invocable<F, Args...>
@@ -220,26 +322,25 @@ namespace doge::hid {
 
       static void button_callback(GLFWwindow*, int key, int action, int mods) noexcept
       {
-         if (action == GLFW_PRESS && key_mask_[key] != key_state::down)
-            key_mask_[key] = key_state::press;
-         else if (action == GLFW_RELEASE && key_mask_[key] != key_state::up)
-            key_mask_[key] = key_state::release;
-
-         modifiers(mods);
+         auto const e = input_event{input_event::device::mouse_button, key, action, mods};
+         if (accept(e))
+            apply(e);
       }
 
       static void cursor_callback(GLFWwindow*, double x, double y) noexcept
       {
-         cursor_[previous] = cursor_[current];
-         cursor_[current].x = static_cast<float>(x);
-         cursor_[current].y = static_cast<float>(y);
+         auto const e = input_event{input_event::device::cursor, 0, 0, 0,
+            {static_cast<float>(x), static_cast<float>(y)}};
+         if (accept(e))
+            apply(e);
       }
 
       static void scroll_callback(GLFWwindow*, double x, double y) noexcept
       {
-         scroll_[previous] = scroll_[current];
-         scroll_[current].x = static_cast<float>(x);
-         scroll_[current].y = static_cast<float>(y);
+         auto const e = input_event{input_event::device::scroll, 0, 0, 0,
+            {static_cast<float>(x), static_cast<float>(y)}};
+         if (accept(e))
+            apply(e);
       }
 
       template <typename F, typename... Args>
@@ -256,6 +357,16 @@ namespace doge::hid {
       }
    };
 
+   /// @brief Updates whichever device e belongs to, as if GLFW had reported it.
+   ///
+   inline void apply(input_event const& e) noexcept
+   {
+      if (e.source == input_event::device::keyboard)
+         keyboard::apply(e);
+      else
+         mouse::apply(e);
+   }
+
    template <typename T, typename F, typename... Args>
    requires
       std::experimental::ranges::Invocable<F, Args...> &&
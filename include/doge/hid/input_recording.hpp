@@ -0,0 +1,89 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_HID_INPUT_RECORDING_HPP
+#define DOGE_HID_INPUT_RECORDING_HPP
+
+#include <cstddef>
+#include <doge/hid.hpp>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace doge::hid {
+   /// @brief Writes every input event, and the length of every frame, to a binary log.
+   ///
+   /// The log is a sequence of records. A frame record holds the frame's displacement, and is
+   /// followed by the events that were polled at the end of that frame. Events are therefore
+   /// timestamped at frame granularity, which is what a frame-exact replay needs.
+   ///
+   class input_recorder {
+   public:
+      /// @throws std::runtime_error if path can't be opened for writing.
+      ///
+      explicit input_recorder(std::string const& path);
+      ~input_recorder();
+
+      input_recorder(input_recorder const&) = delete;
+      input_recorder& operator=(input_recorder const&) = delete;
+
+      /// @brief Starts a new frame that lasted displacement seconds.
+      ///
+      void frame(double displacement);
+   private:
+      std::ofstream out_;
+
+      static void record(input_event const& e, void* recorder) noexcept;
+   };
+
+   /// @brief Reads a log written by input_recorder, and feeds it back into the HID state.
+   ///
+   /// Live input is ignored for as long as a player exists.
+   ///
+   class input_player {
+   public:
+      /// @throws std::runtime_error if path can't be read, or isn't an input recording.
+      ///
+      explicit input_player(std::string const& path);
+      ~input_player();
+
+      input_player(input_player const&) = delete;
+      input_player& operator=(input_player const&) = delete;
+
+      /// @brief Advances to the next recorded frame.
+      /// @returns The frame's displacement, or std::nullopt if the recording has finished.
+      ///
+      std::optional<double> next_frame() noexcept;
+
+      /// @brief Applies the events that were polled at the end of the current frame.
+      ///
+      void poll_events() noexcept;
+   private:
+      struct frame_record {
+         double displacement;
+         std::size_t first_event;
+      };
+
+      std::vector<input_event> events_;
+      std::vector<frame_record> frames_;
+      std::size_t next_frame_ = 0;
+      std::size_t next_event_ = 0;
+
+      void apply_until(std::size_t last) noexcept;
+   };
+} // namespace doge::hid
+
+#endif // DOGE_HID_INPUT_RECORDING_HPP
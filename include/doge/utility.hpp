@@ -1,4 +1,10 @@
 #include "doge/utility/file.hpp"
+#include "doge/utility/frame_limiter.hpp"
+#include "doge/utility/frame_pipeline.hpp"
+#include "doge/utility/headless_context.hpp"
+#include "doge/utility/job_system.hpp"
+#include "doge/utility/mesh_optimisation.hpp"
+#include "doge/utility/profiler.hpp"
 #include "doge/utility/reference_count.hpp"
 #include "doge/utility/screen_data.hpp"
 #include "doge/utility/type_traits.hpp"
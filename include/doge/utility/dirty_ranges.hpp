@@ -0,0 +1,135 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_DIRTY_RANGES_HPP
+#define DOGE_UTILITY_DIRTY_RANGES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/concepts>
+#include <gsl/gsl>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief Bytes that have been written on the CPU, but not yet uploaded to the GPU.
+   ///
+   /// Each write is staged with its byte offset. Writes that overlap or touch a staged range are
+   /// merged into it, with the newer bytes taking precedence, so the ranges are always disjoint,
+   /// sorted by offset, and separated by at least one clean byte.
+   ///
+   class dirty_ranges {
+   public:
+      struct range {
+         std::size_t offset;
+         std::vector<std::byte> bytes;
+
+         [[nodiscard]] std::size_t end() const noexcept
+         {
+            return offset + ranges::size(bytes);
+         }
+      };
+
+      /// @brief Stages bytes to be uploaded at offset.
+      ///
+      void add(std::size_t const offset, gsl::span<std::byte const> const bytes)
+      {
+         if (ranges::empty(bytes))
+            return;
+
+         auto const end = offset + ranges::size(bytes);
+
+         // The ranges that overlap or touch [offset, end) are contiguous in ranges_.
+         auto const first = ranges::find_if(ranges_, [offset](range const& r) {
+            return r.end() >= offset; });
+         auto const last = std::find_if(first, ranges::end(ranges_), [end](range const& r) {
+            return r.offset > end; });
+
+         if (first == last) {
+            ranges_.insert(first, range{offset, {ranges::begin(bytes), ranges::end(bytes)}});
+            return;
+         }
+
+         auto merged = range{std::min(offset, first->offset), {}};
+         merged.bytes.resize(std::max(end, std::prev(last)->end()) - merged.offset);
+         for (auto r = first; r != last; ++r)
+            ranges::copy(r->bytes, ranges::begin(merged.bytes) + (r->offset - merged.offset));
+         ranges::copy(bytes, ranges::begin(merged.bytes) + (offset - merged.offset));
+
+         *first = std::move(merged);
+         ranges_.erase(std::next(first), last);
+      }
+
+      /// @brief Calls f with the offset and bytes of each staged range, in order of offset.
+      ///
+      template <ranges::Invocable<std::size_t, gsl::span<std::byte const>> F>
+      void for_each(F f) const
+      {
+         for (auto const& r : ranges_)
+            ranges::invoke(f, r.offset, gsl::span<std::byte const>{r.bytes});
+      }
+
+      /// @brief The offset of the first staged byte.
+      /// @note Only valid when the ranges aren't empty.
+      ///
+      [[nodiscard]] std::size_t first() const noexcept
+      {
+         Expects(not empty());
+         return ranges_.front().offset;
+      }
+
+      /// @brief One past the offset of the last staged byte.
+      /// @note Only valid when the ranges aren't empty.
+      ///
+      [[nodiscard]] std::size_t last() const noexcept
+      {
+         Expects(not empty());
+         return ranges_.back().end();
+      }
+
+      /// @brief The number of bytes that are staged.
+      ///
+      [[nodiscard]] std::size_t bytes() const noexcept
+      {
+         auto result = std::size_t{0};
+         for (auto const& r : ranges_)
+            result += ranges::size(r.bytes);
+         return result;
+      }
+
+      /// @brief The number of disjoint ranges.
+      ///
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return ranges::size(ranges_);
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return ranges::empty(ranges_);
+      }
+
+      void clear() noexcept
+      {
+         ranges_.clear();
+      }
+   private:
+      std::vector<range> ranges_;
+   };
+} // namespace doge
+
+#endif // DOGE_UTILITY_DIRTY_RANGES_HPP
@@ -0,0 +1,189 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_FRAME_LIMITER_HPP
+#define DOGE_UTILITY_FRAME_LIMITER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/concepts>
+#include <gsl/gsl>
+#include <thread>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief How closely the most recent frame kept to its schedule, in seconds.
+   ///
+   struct frame_pacing {
+      /// @brief How long after its target time the frame was released. This is the jitter that the
+      ///    limiter itself introduces.
+      double wake_error = 0.0;
+
+      /// @brief How long after its deadline the frame finished. Negative values mean that the frame
+      ///    finished early.
+      double deadline_error = 0.0;
+
+      /// @brief The time between the frame being released and it finishing.
+      double work = 0.0;
+   };
+
+   /// @brief The clock that frame_limiter waits on: std::chrono::steady_clock, in seconds.
+   ///
+   struct steady_frame_clock {
+      static double now() noexcept
+      {
+         using seconds = std::chrono::duration<double>;
+         return seconds{std::chrono::steady_clock::now().time_since_epoch()}.count();
+      }
+
+      static void sleep_for(double const s)
+      {
+         std::this_thread::sleep_for(std::chrono::duration<double>{s});
+      }
+
+      static void yield() noexcept
+      {
+         std::this_thread::yield();
+      }
+   };
+
+   /// @brief Holds the game loop to a target frame rate.
+   ///
+   /// The limiter sleeps for most of the wait, and then spins for the last spin_threshold seconds,
+   /// since sleeps routinely overshoot by a millisecond or more.
+   /// @tparam Clock Provides now(), in seconds, and the sleep_for(seconds) and yield() that the
+   ///    limiter waits with. Tests substitute a clock that they can advance by hand.
+   ///
+   template <typename Clock = steady_frame_clock>
+   class basic_frame_limiter {
+   public:
+      enum class mode {
+         /// @brief Frames start on period boundaries, and finish whenever they finish.
+         immediate,
+
+         /// @brief Frames start as late as possible while still finishing by their deadline.
+         ///
+         /// The start time is predicted from the longest of the last few frames, plus a safety
+         /// margin. Input is sampled just before the frame starts, so it is as fresh as it can be
+         /// when the frame is presented.
+         just_in_time
+      };
+
+      /// @brief A limiter that doesn't limit anything.
+      ///
+      basic_frame_limiter() = default;
+
+      /// @param hertz The target number of frames per second.
+      /// @param m When frames should start relative to their deadline.
+      /// @param spin_threshold The number of seconds before the target time to stop sleeping and
+      ///    start spinning.
+      /// @param safety_margin The number of seconds that just_in_time frames are started early
+      ///    by, on top of the predicted frame time.
+      ///
+      explicit basic_frame_limiter(double const hertz, mode const m = mode::immediate,
+         double const spin_threshold = 0.002, double const safety_margin = 0.001) noexcept
+         : period_{1.0 / hertz},
+           spin_threshold_{spin_threshold},
+           safety_margin_{safety_margin},
+           mode_{m}
+      {
+         Expects(hertz > 0.0);
+         Expects(spin_threshold >= 0.0);
+         Expects(safety_margin >= 0.0);
+      }
+
+      /// @brief Ends the current frame, and blocks until the next one should start.
+      ///
+      /// This should be called after the frame has been presented, and before input is polled.
+      ///
+      void pace()
+      {
+         if (not limited())
+            return;
+
+         auto const finished = now();
+         if (released_ > 0.0) {
+            pacing_.work = finished - released_;
+            pacing_.deadline_error = finished - deadline_;
+            work_[recent_++ % ranges::size(work_)] = pacing_.work;
+         }
+
+         // Missing a deadline by more than a whole period restarts the schedule, rather than
+         // rushing out a burst of frames to catch up.
+         deadline_ = (released_ == 0.0 || finished - deadline_ > period_) ? finished + period_
+                                                                          : deadline_ + period_;
+
+         auto const target = mode_ == mode::immediate
+                           ? deadline_ - period_
+                           : deadline_ - *ranges::max_element(work_) - safety_margin_;
+         wait_until(target);
+         released_ = now();
+         pacing_.wake_error = std::max(0.0, released_ - std::max(target, finished));
+      }
+
+      /// @brief The pacing of the most recently finished frame.
+      ///
+      [[nodiscard]] frame_pacing const& pacing() const noexcept
+      {
+         return pacing_;
+      }
+
+      /// @brief Checks if the limiter has a target frame rate.
+      ///
+      [[nodiscard]] bool limited() const noexcept
+      {
+         return period_ > 0.0;
+      }
+
+      /// @brief The target number of seconds per frame, or zero if the limiter doesn't limit.
+      ///
+      [[nodiscard]] double period() const noexcept
+      {
+         return period_;
+      }
+   private:
+      double period_ = 0.0;
+      double spin_threshold_ = 0.002;
+      double safety_margin_ = 0.001;
+      mode mode_ = mode::immediate;
+
+      double deadline_ = 0.0;
+      double released_ = 0.0;
+      std::array<double, 16> work_ = {};
+      std::size_t recent_ = 0;
+      frame_pacing pacing_;
+
+      void wait_until(double const target) const
+      {
+         if (auto const sleep = target - spin_threshold_ - now(); sleep > 0.0)
+            Clock::sleep_for(sleep);
+
+         while (now() < target)
+            Clock::yield();
+      }
+
+      static double now() noexcept
+      {
+         return Clock::now();
+      }
+   };
+
+   using frame_limiter = basic_frame_limiter<>;
+} // namespace doge
+
+#endif // DOGE_UTILITY_FRAME_LIMITER_HPP
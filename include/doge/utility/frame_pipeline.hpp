@@ -0,0 +1,114 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_FRAME_PIPELINE_HPP
+#define DOGE_UTILITY_FRAME_PIPELINE_HPP
+
+#include <array>
+#include <condition_variable>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/functional>
+#include <mutex>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief Double-buffered hand-off of frame packets from a producer thread to a consumer thread.
+   ///
+   /// The producer fills back() and then calls publish(); the consumer reads the most recently
+   /// published packet in consume(). The two threads never touch the same packet, and the producer
+   /// can run at most one frame ahead of the consumer.
+   /// @tparam Frame The state that the producer hands to the consumer each frame.
+   ///
+   template <ranges::Semiregular Frame>
+   class frame_pipeline {
+   public:
+      /// @brief The packet that the producer is currently allowed to write to.
+      ///
+      /// The two packets alternate, so after publish() this still holds what the producer wrote two
+      /// frames ago, not the frame it just published. Overwrite every member that the consumer
+      /// reads, or copy the previous frame in before making incremental changes.
+      ///
+      Frame& back() noexcept
+      {
+         return frames_[back_];
+      }
+
+      /// @brief Makes back() visible to the consumer, and hands the producer a new back buffer.
+      ///
+      /// Blocks until the consumer has finished with the previously published packet.
+      /// @returns false if the pipeline has been closed, true otherwise.
+      ///
+      bool publish()
+      {
+         auto lock = std::unique_lock{mutex_};
+         consumed_.wait(lock, [this]{ return not ready_ || closed_; });
+         if (closed_)
+            return false;
+
+         back_ ^= 1;
+         ready_ = true;
+         lock.unlock();
+         published_.notify_one();
+         return true;
+      }
+
+      /// @brief Waits for a packet to be published, and then invokes f with it.
+      /// @returns false if the pipeline was closed before a packet was published, true otherwise.
+      ///
+      template <ranges::Invocable<Frame const&> F>
+      bool consume(F const& f)
+      {
+         auto lock = std::unique_lock{mutex_};
+         published_.wait(lock, [this]{ return ready_ || closed_; });
+         if (not ready_)
+            return false;
+
+         Frame const& front = frames_[back_ ^ 1];
+         lock.unlock();
+
+         ranges::invoke(f, front);
+
+         lock.lock();
+         ready_ = false;
+         lock.unlock();
+         consumed_.notify_one();
+         return true;
+      }
+
+      /// @brief Wakes both threads and stops any further hand-offs.
+      ///
+      void close()
+      {
+         {
+            auto const lock = std::lock_guard{mutex_};
+            closed_ = true;
+            ready_ = false;
+         }
+         published_.notify_all();
+         consumed_.notify_all();
+      }
+   private:
+      std::array<Frame, 2> frames_ = {};
+      int back_ = 0;
+      bool ready_ = false;
+      bool closed_ = false;
+      std::mutex mutex_;
+      std::condition_variable published_;
+      std::condition_variable consumed_;
+   };
+} // namespace doge
+
+#endif // DOGE_UTILITY_FRAME_PIPELINE_HPP
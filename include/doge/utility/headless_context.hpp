@@ -0,0 +1,65 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_HEADLESS_CONTEXT_HPP
+#define DOGE_UTILITY_HEADLESS_CONTEXT_HPP
+
+#include <gl/gl_core.hpp>
+
+namespace doge {
+   /// @brief An OpenGL context that doesn't need a display server.
+   ///
+   /// The context is created through EGL (using the surfaceless platform when it is available, and
+   /// falling back to a pbuffer surface otherwise). Rendering is redirected into a framebuffer
+   /// object that stands in for the default framebuffer, so it works with software drivers such as
+   /// Mesa's llvmpipe on machines that have no GPU.
+   ///
+   class headless_context {
+   public:
+      /// @brief Creates the context, makes it current, loads the GL functions, and binds the
+      /// offscreen framebuffer.
+      /// @throws std::runtime_error if any of the above can't be done.
+      ///
+      headless_context(int width, int height);
+
+      headless_context(headless_context const&) = delete;
+      headless_context& operator=(headless_context const&) = delete;
+
+      ~headless_context();
+
+      void make_current() noexcept;
+
+      void release() noexcept;
+
+      /// @brief The framebuffer object that acts as the default framebuffer.
+      ///
+      GLuint framebuffer() const noexcept
+      {
+         return framebuffer_;
+      }
+   private:
+      void* display_ = nullptr;
+      void* context_ = nullptr;
+      void* surface_ = nullptr;
+      GLuint framebuffer_ = 0;
+      GLuint colour_ = 0;
+      GLuint depth_stencil_ = 0;
+
+      void create(int width, int height);
+      void destroy() noexcept;
+   };
+} // namespace doge
+
+#endif // DOGE_UTILITY_HEADLESS_CONTEXT_HPP
@@ -0,0 +1,227 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_JOB_SYSTEM_HPP
+#define DOGE_UTILITY_JOB_SYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/functional>
+#include <experimental/ranges/iterator>
+#include <functional>
+#include <gsl/gsl>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   namespace detail {
+      struct job_state;
+
+      struct job {
+         std::function<void()> work;
+         std::shared_ptr<job_state> state;
+      };
+
+      struct job_state {
+         explicit job_state(int const jobs) noexcept
+            : unfinished{jobs}
+         {}
+
+         std::atomic<int> unfinished;
+         std::mutex mutex;
+         std::vector<job> continuations;
+      };
+   } // namespace detail
+
+   /// @brief Refers to a job (or a group of jobs) that has been handed to a job_system.
+   ///
+   class job_handle {
+   public:
+      job_handle() = default;
+
+      /// @brief Checks if the job has finished. A default-constructed handle is always done.
+      ///
+      [[nodiscard]] bool done() const noexcept
+      {
+         return state_ == nullptr || state_->unfinished.load(std::memory_order_acquire) == 0;
+      }
+   private:
+      friend class job_system;
+
+      std::shared_ptr<detail::job_state> state_;
+
+      explicit job_handle(std::shared_ptr<detail::job_state> state) noexcept
+         : state_{std::move(state)}
+      {}
+   };
+
+   /// @brief A work-stealing scheduler for short, independent jobs.
+   ///
+   /// Every worker thread owns a deque of jobs. A worker pushes and pops jobs at the back of its own
+   /// deque, and when that runs dry, steals from the front of another worker's deque. Threads that
+   /// aren't workers (e.g. the thread that runs engine::play) share an extra deque, and help out
+   /// with other jobs while they wait.
+   /// @note Jobs must not throw: an exception that escapes a job calls std::terminate.
+   ///
+   class job_system {
+   public:
+      /// @param workers The number of threads to spawn, in addition to the calling thread.
+      ///
+      explicit job_system(int workers = default_worker_count());
+      ~job_system();
+
+      job_system(job_system const&) = delete;
+      job_system& operator=(job_system const&) = delete;
+
+      /// @brief Schedules f to be run on any thread.
+      ///
+      template <ranges::Invocable F>
+      job_handle spawn(F f)
+      {
+         auto state = std::make_shared<detail::job_state>(1);
+         push(make_job(std::move(f), state));
+         return job_handle{std::move(state)};
+      }
+
+      /// @brief Schedules f to be run once parent has finished.
+      ///
+      template <ranges::Invocable F>
+      job_handle then(job_handle const& parent, F f)
+      {
+         auto state = std::make_shared<detail::job_state>(1);
+         auto continuation = make_job(std::move(f), state);
+
+         if (parent.state_ != nullptr) {
+            auto const lock = std::lock_guard{parent.state_->mutex};
+            if (not parent.done()) {
+               outstanding_.fetch_add(1, std::memory_order_relaxed);
+               parent.state_->continuations.push_back(std::move(continuation));
+               return job_handle{std::move(state)};
+            }
+         }
+
+         push(std::move(continuation));
+         return job_handle{std::move(state)};
+      }
+
+      /// @brief Invokes f with every element in [first, last), splitting the range into chunks of
+      ///    at most grain elements that are run in parallel. Returns once every element is done.
+      ///
+      template <ranges::RandomAccessIterator I, ranges::Sentinel<I> S,
+         ranges::Invocable<ranges::reference_t<I>> F>
+      void parallel_for(I const first, S const last, F const& f,
+         ranges::difference_type_t<I> const grain = 64)
+      {
+         Expects(grain > 0);
+         auto const size = ranges::distance(first, last);
+         if (size == 0)
+            return;
+
+         auto const chunks = gsl::narrow_cast<int>((size + grain - 1) / grain);
+         auto group = std::make_shared<detail::job_state>(chunks);
+         for (auto chunk = 0; chunk < chunks; ++chunk) {
+            auto const begin = first + chunk * grain;
+            auto const end = first + std::min(size, (chunk + 1) * grain);
+            push(make_job([begin, end, &f]{
+               for (auto i = begin; i != end; ++i)
+                  ranges::invoke(f, *i);
+            }, group));
+         }
+
+         wait(job_handle{std::move(group)});
+      }
+
+      /// @brief Invokes f with every element in r in parallel. Returns once every element is done.
+      ///
+      template <ranges::RandomAccessRange R,
+         ranges::Invocable<ranges::reference_t<ranges::iterator_t<R>>> F>
+      void parallel_for(R&& r, F const& f,
+         ranges::difference_type_t<ranges::iterator_t<R>> const grain = 64)
+      {
+         parallel_for(ranges::begin(r), ranges::end(r), f, grain);
+      }
+
+      /// @brief Runs other jobs on the calling thread until job has finished.
+      ///
+      void wait(job_handle const& job);
+
+      /// @brief Runs jobs on the calling thread until every job that has been spawned (including
+      ///    continuations that haven't been scheduled yet) has finished.
+      ///
+      /// engine calls this at the end of every frame, so a job never outlives the frame that spawned
+      /// it.
+      ///
+      void wait_for_frame();
+
+      /// @brief The number of threads that run jobs, including the calling thread.
+      ///
+      [[nodiscard]] int concurrency() const noexcept
+      {
+         return gsl::narrow_cast<int>(ranges::size(workers_)) + 1;
+      }
+   private:
+      using job = detail::job;
+
+      struct worker_queue {
+         std::mutex mutex;
+         std::deque<job> jobs;
+      };
+
+      // queues_.front() is shared by every thread that isn't a worker.
+      std::vector<std::unique_ptr<worker_queue>> queues_;
+      std::vector<std::thread> workers_;
+      std::atomic<int> outstanding_{0};
+      std::atomic<int> queued_{0};
+      std::atomic<bool> stopping_{false};
+      std::mutex sleep_mutex_;
+      std::condition_variable wake_;
+
+      static int default_worker_count() noexcept
+      {
+         return std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+      }
+
+      template <typename F>
+      static job make_job(F f, std::shared_ptr<detail::job_state> state)
+      {
+         return {[f = std::move(f)]() mutable { ranges::invoke(f); }, std::move(state)};
+      }
+
+      /// @brief Schedules j, and counts it towards wait_for_frame.
+      ///
+      void push(job j);
+
+      /// @brief Schedules j, which has already been counted towards wait_for_frame.
+      ///
+      void schedule(job j);
+
+      bool run_one(std::size_t self) noexcept;
+      bool try_pop(std::size_t self, job& result) noexcept;
+      void execute(job& j) noexcept;
+      void work(std::size_t self) noexcept;
+      std::size_t queue_index() const noexcept;
+   };
+} // namespace doge
+
+#endif // DOGE_UTILITY_JOB_SYSTEM_HPP
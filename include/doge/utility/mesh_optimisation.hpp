@@ -0,0 +1,249 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_MESH_OPTIMISATION_HPP
+#define DOGE_UTILITY_MESH_OPTIMISATION_HPP
+
+#include "doge/utility/std_layout_tuple.hpp"
+#include <array>
+#include <cstddef>
+#include <experimental/ranges/iterator>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <limits>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief The vertex count of a simulated first-in, first-out post-transform cache, which is
+   ///    what the optimisations below aim for, and what they're measured with.
+   ///
+   inline constexpr std::size_t default_vertex_cache_size = 16;
+
+   /// @brief How much an optimise_mesh() call helped.
+   ///
+   struct mesh_statistics {
+      /// @brief The number of vertices that went in, and the number that are left once duplicates
+      ///    have been removed.
+      std::size_t soup_vertices = 0;
+      std::size_t unique_vertices = 0;
+
+      /// @brief The average number of vertices that miss the cache per triangle, before and after
+      ///    the triangles are reordered. It's 3 at worst, and close to 0.5 for a large regular grid.
+      double acmr_before = 0.0;
+      double acmr_after = 0.0;
+   };
+
+   /// @brief Vertices and the triangles that index them, ready for a vertex_element_buffer:
+   ///
+   ///    auto const mesh = doge::optimise_mesh(cube_with_normal);
+   ///    auto vbo = doge::make_vertex_element_buffer(mesh);
+   ///
+   template <typename... Ts>
+   struct indexed_mesh {
+      std::vector<std_layout_tuple<Ts...>> vertices;
+      std::vector<GLuint> elements;
+      mesh_statistics statistics;
+   };
+
+   /// @brief Finds the distinct vertices among count vertices of stride bytes each.
+   /// @returns For each vertex, the index of the first vertex that's identical to it, renumbered so
+   ///    that the distinct vertices are 0, 1, 2, ... in the order that they first appear.
+   /// @note Vertices are compared byte for byte, so 0.0f and -0.0f are different.
+   ///
+   std::vector<GLuint> index_vertices(gsl::span<std::byte const> vertices, std::size_t stride);
+
+   /// @brief Reorders triangles so that their vertices are more likely to still be in the
+   ///    post-transform cache, using Tipsify (Sander, Nehab, and Barczak, 2007), which is linear in
+   ///    the number of triangles.
+   ///
+   void optimise_vertex_cache(gsl::span<GLuint> elements, std::size_t vertex_count,
+      std::size_t cache_size = default_vertex_cache_size);
+
+   /// @brief Renumbers the vertices in the order that elements first uses them, so that they're
+   ///    fetched from memory front to back.
+   /// @returns The new index of each old vertex. Vertices that aren't used are moved to the end.
+   ///
+   std::vector<GLuint> optimise_vertex_fetch(gsl::span<GLuint> elements, std::size_t vertex_count);
+
+   /// @brief The average cache miss ratio: the number of vertices that miss a first-in, first-out
+   ///    cache of cache_size vertices, per triangle.
+   ///
+   double average_cache_miss_ratio(gsl::span<GLuint const> elements, std::size_t vertex_count,
+      std::size_t cache_size = default_vertex_cache_size);
+
+   /// @brief Moves each vertex to the index that remap gives it.
+   ///
+   template <typename T>
+   std::vector<T> remap_vertices(gsl::span<T const> const vertices,
+      gsl::span<GLuint const> const remap)
+   {
+      Expects(ranges::size(vertices) == ranges::size(remap));
+      auto result = std::vector<T>(ranges::size(vertices));
+      for (auto i = std::ptrdiff_t{0}; i < ranges::size(vertices); ++i)
+         result[remap[i]] = vertices[i];
+      return result;
+   }
+
+   /// @brief Turns a triangle soup into an indexed mesh: duplicate vertices are merged, the
+   ///    triangles are reordered for the vertex cache, and then the vertices are reordered for
+   ///    fetching.
+   ///
+   template <typename... Ts>
+   indexed_mesh<Ts...> optimise_mesh(gsl::span<std_layout_tuple<Ts...> const> const soup)
+   {
+      using vertex = std_layout_tuple<Ts...>;
+      Expects(ranges::size(soup) % 3 == 0);
+
+      auto result = indexed_mesh<Ts...>{};
+      result.elements = index_vertices(gsl::as_bytes(soup), sizeof(vertex));
+
+      auto unique = std::size_t{0};
+      for (auto i = std::ptrdiff_t{0}; i < ranges::size(soup); ++i) {
+         if (result.elements[i] == unique) {
+            result.vertices.push_back(soup[i]);
+            ++unique;
+         }
+      }
+
+      result.statistics.soup_vertices = ranges::size(soup);
+      result.statistics.unique_vertices = unique;
+      result.statistics.acmr_before = average_cache_miss_ratio(result.elements, unique);
+
+      optimise_vertex_cache(result.elements, unique);
+      result.statistics.acmr_after = average_cache_miss_ratio(result.elements, unique);
+
+      auto const remap = optimise_vertex_fetch(result.elements, unique);
+      result.vertices = remap_vertices(gsl::span<vertex const>{result.vertices},
+         gsl::span<GLuint const>{remap});
+      return result;
+   }
+
+   template <typename... Ts>
+   indexed_mesh<Ts...> optimise_mesh(std::vector<std_layout_tuple<Ts...>> const& soup)
+   {
+      return optimise_mesh(gsl::span<std_layout_tuple<Ts...> const>{soup});
+   }
+
+   /// @brief The triangles that are left after simplify(), and how far they may be from the
+   ///    original surface.
+   ///
+   struct simplification {
+      std::vector<GLuint> elements;
+
+      /// @brief The largest quadric error of any collapse, which is roughly the distance between
+      ///    the two surfaces, in the same units as the positions.
+      float error = 0.0f;
+   };
+
+   /// @brief Removes triangles by collapsing edges, cheapest first, as measured by quadric error
+   ///    metrics (Garland and Heckbert, 1997), until there are at most target_count elements left,
+   ///    or every remaining collapse would cost more than max_error.
+   ///
+   /// Vertices are only ever moved onto one of their neighbours, so the simplified triangles index
+   /// the original vertices, and their normals and texture coordinates are kept as they are.
+   /// Vertices on a border, or on a seam (where vertices with the same position have different
+   /// attributes), are never moved, so seams and holes keep their shape.
+   ///
+   simplification simplify(gsl::span<GLuint const> elements,
+      gsl::span<std::array<float, 3> const> positions, std::size_t target_count,
+      float max_error = std::numeric_limits<float>::max());
+
+   /// @brief One level of detail in a lod_mesh.
+   ///
+   struct mesh_lod {
+      /// @brief The index of the level's first element, and its number of elements.
+      std::size_t first = 0;
+      std::size_t count = 0;
+
+      /// @brief How far the level may be from the original mesh, in the same units as the
+      ///    positions.
+      float error = 0.0f;
+   };
+
+   /// @brief A mesh and its simplified versions, which all share its vertices. The elements of
+   ///    every level are stored one after the other, most detailed first, so that they can be
+   ///    uploaded to a single vertex_element_buffer and drawn with as_draw_call(lods[i]).
+   ///
+   template <typename... Ts>
+   struct lod_mesh {
+      std::vector<std_layout_tuple<Ts...>> vertices;
+      std::vector<GLuint> elements;
+      std::vector<mesh_lod> lods;
+   };
+
+   /// @brief Builds up to lod_count levels of detail, each with about ratio times as many triangles
+   ///    as the one before it. The first level is mesh itself.
+   /// @note The first attribute of each vertex is its position. Fewer levels are made if the mesh
+   ///    can't be simplified any further within max_error.
+   ///
+   template <typename... Ts>
+   lod_mesh<Ts...> make_lods(indexed_mesh<Ts...> const& mesh, std::size_t const lod_count,
+      double const ratio = 0.5, float const max_error = std::numeric_limits<float>::max())
+   {
+      Expects(lod_count > 0);
+      Expects(0.0 < ratio && ratio < 1.0);
+
+      auto positions = std::vector<std::array<float, 3>>{};
+      positions.reserve(ranges::size(mesh.vertices));
+      for (auto const& v : mesh.vertices) {
+         auto const& p = get<0>(v);
+         positions.push_back({p[0], p[1], p[2]});
+      }
+
+      auto result = lod_mesh<Ts...>{mesh.vertices, mesh.elements, {}};
+      result.lods.push_back(mesh_lod{0, ranges::size(mesh.elements), 0.0f});
+
+      auto level = mesh.elements;
+      while (ranges::size(result.lods) < lod_count) {
+         auto const triangles = static_cast<std::size_t>(ratio * (ranges::size(level) / 3));
+         auto next = simplify(level, positions, 3 * triangles, max_error);
+         if (ranges::size(next.elements) == ranges::size(level) || ranges::empty(next.elements))
+            break;
+
+         optimise_vertex_cache(next.elements, ranges::size(positions));
+
+         // Each level's error is measured from the one before it, so adding them up bounds the
+         // error from the original.
+         auto const error = result.lods.back().error + next.error;
+         result.lods.push_back(mesh_lod{ranges::size(result.elements),
+            ranges::size(next.elements), error});
+         result.elements.insert(ranges::end(result.elements), ranges::begin(next.elements),
+            ranges::end(next.elements));
+         level = std::move(next.elements);
+      }
+
+      return result;
+   }
+
+   /// @brief Picks the least detailed level whose error covers no more than max_pixels on screen.
+   /// @param pixels_per_unit How many pixels one unit at the mesh's distance covers, such as
+   ///    camera::pixels_per_unit() gives.
+   ///
+   inline std::size_t select_lod(gsl::span<mesh_lod const> const lods, float const pixels_per_unit,
+      float const max_pixels = 1.0f) noexcept
+   {
+      auto result = std::size_t{0};
+      for (auto i = std::ptrdiff_t{0}; i < ranges::size(lods); ++i) {
+         if (lods[i].error * pixels_per_unit <= max_pixels)
+            result = gsl::narrow_cast<std::size_t>(i);
+      }
+
+      return result;
+   }
+} // namespace doge
+
+#endif // DOGE_UTILITY_MESH_OPTIMISATION_HPP
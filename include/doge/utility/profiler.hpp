@@ -0,0 +1,349 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_PROFILER_HPP
+#define DOGE_UTILITY_PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <doge/gl/memory.hpp>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/iterator>
+#include <gl/gl_core.hpp>
+#include <gsl/gsl>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace doge {
+   namespace ranges = std::experimental::ranges;
+
+   /// @brief The 50th, 95th, and 99th percentiles of a set of timings, in seconds.
+   ///
+   struct percentiles {
+      double p50 = 0.0;
+      double p95 = 0.0;
+      double p99 = 0.0;
+   };
+
+   /// @brief Percentiles for the CPU and GPU sides of a frame, or of a named scope.
+   ///
+   struct timing_statistics {
+      percentiles cpu;
+      percentiles gpu;
+   };
+
+   /// @brief The time spent in a single profiled scope, in seconds.
+   ///
+   struct scope_timing {
+      std::string name;
+      int depth = 0;
+      double cpu = 0.0;
+      double gpu = 0.0;
+   };
+
+   /// @brief The CPU/GPU breakdown of one frame, in seconds.
+   ///
+   struct frame_timing {
+      std::int64_t frame = 0;
+      double cpu = 0.0;
+      double gpu = 0.0;
+      std::vector<scope_timing> scopes;
+   };
+
+   /// @brief Measures where frame time goes on both the CPU and the GPU.
+   ///
+   /// Each scope is bracketed by a pair of GL_TIMESTAMP queries (which, unlike GL_TIME_ELAPSED,
+   /// may nest) and a pair of steady_clock readings. Query results are collected frames_in_flight
+   /// frames after they were issued, and are only read if the GPU has already made them available,
+   /// so profiling never stalls the pipeline: a frame whose results still aren't ready is dropped.
+   /// @note Scopes issue GL commands, so they must be opened on the thread that owns the context.
+   ///    When the engine is pipelined, that's the render thread.
+   ///
+   class profiler {
+      using query_pair = gpu_ptr<resource_type::query, 2>;
+   public:
+      /// @brief The number of frames that may be in flight before their queries are read back.
+      ///
+      static constexpr int frames_in_flight = 4;
+
+      /// @brief The number of completed frames that are kept for statistics.
+      ///
+      static constexpr int history_size = 256;
+
+      /// @brief Closes a profiled scope when it goes out of scope.
+      ///
+      /// A scope belongs to the frame that it was opened in. If it's still open when that frame
+      /// ends, end_frame() closes it, and destroying it afterwards does nothing.
+      ///
+      class scope {
+      public:
+         scope(scope const&) = delete;
+         scope& operator=(scope const&) = delete;
+
+         ~scope()
+         {
+            if (profiler_ != nullptr)
+               profiler_->end_scope(frame_, index_);
+         }
+      private:
+         friend profiler;
+
+         profiler* profiler_;
+         std::int64_t frame_;
+         int index_;
+
+         scope(profiler* const p, std::int64_t const frame, int const index) noexcept
+            : profiler_{p},
+              frame_{frame},
+              index_{index}
+         {}
+      };
+
+      /// @brief Opens a scope named name, which is timed until the returned object is destroyed.
+      /// @note Scopes opened outside of a frame aren't recorded.
+      ///
+      [[nodiscard]] scope profile(std::string name)
+      {
+         if (not recording_)
+            return scope{nullptr, 0, 0};
+
+         auto& slot = current_slot();
+         auto const index = gsl::narrow_cast<int>(ranges::size(slot.scopes));
+         if (ranges::size(slot.scopes) == ranges::size(slot.queries))
+            slot.queries.emplace_back();
+
+         slot.scopes.push_back({std::move(name), depth_++, now(), 0.0, true});
+         gl::QueryCounter(slot.queries[index][0], gl::TIMESTAMP);
+         return scope{this, frame_, index};
+      }
+
+      /// @brief Collects any results that are ready, and starts timing a new frame.
+      ///
+      void begin_frame()
+      {
+         auto& slot = current_slot();
+         if (slot.pending)
+            collect(slot);
+
+         slot.scopes.clear();
+         slot.pending = false;
+         slot.cpu_begin = now();
+         gl::QueryCounter(slot.frame_queries[0], gl::TIMESTAMP);
+         depth_ = 0;
+         recording_ = true;
+      }
+
+      /// @brief Stops timing the current frame.
+      ///
+      void end_frame()
+      {
+         Expects(recording_);
+         auto& slot = current_slot();
+         for (auto i = decltype(ranges::size(slot.scopes)){0}; i < ranges::size(slot.scopes); ++i) {
+            if (slot.scopes[i].open)
+               close_scope(slot, i);
+         }
+
+         gl::QueryCounter(slot.frame_queries[1], gl::TIMESTAMP);
+         slot.cpu_end = now();
+         slot.frame = frame_++;
+         slot.pending = true;
+         recording_ = false;
+      }
+
+      /// @brief The most recent frame whose GPU timings have been read back.
+      ///
+      [[nodiscard]] std::optional<frame_timing> latest() const
+      {
+         auto const lock = std::lock_guard{mutex_};
+         if (ranges::empty(history_))
+            return std::nullopt;
+         return history_.back();
+      }
+
+      /// @brief Every frame that is still in the history, oldest first.
+      ///
+      [[nodiscard]] std::vector<frame_timing> history() const
+      {
+         auto const lock = std::lock_guard{mutex_};
+         return {ranges::begin(history_), ranges::end(history_)};
+      }
+
+      /// @brief Percentiles of whole-frame times over the history.
+      ///
+      [[nodiscard]] timing_statistics statistics() const
+      {
+         return statistics_if([](frame_timing const& f) {
+            return std::optional{std::pair{f.cpu, f.gpu}};
+         });
+      }
+
+      /// @brief Percentiles of the time spent in scopes called name over the history.
+      ///
+      /// If a scope is opened more than once in a frame, its timings are summed for that frame.
+      ///
+      [[nodiscard]] timing_statistics statistics(std::string_view const name) const
+      {
+         return statistics_if([name](frame_timing const& f) {
+            auto result = std::optional<std::pair<double, double>>{};
+            for (auto const& s : f.scopes) {
+               if (s.name == name) {
+                  auto& [cpu, gpu] = result ? *result : result.emplace(0.0, 0.0);
+                  cpu += s.cpu;
+                  gpu += s.gpu;
+               }
+            }
+            return result;
+         });
+      }
+
+      /// @brief The number of frames that were discarded because their results weren't ready.
+      ///
+      [[nodiscard]] std::int64_t dropped_frames() const noexcept
+      {
+         return dropped_;
+      }
+   private:
+      struct scope_record {
+         std::string name;
+         int depth;
+         double cpu_begin;
+         double cpu_end;
+         bool open;
+      };
+
+      struct frame_slot {
+         query_pair frame_queries;
+         std::vector<query_pair> queries;
+         std::vector<scope_record> scopes;
+         std::int64_t frame = 0;
+         double cpu_begin = 0.0;
+         double cpu_end = 0.0;
+         bool pending = false;
+      };
+
+      std::array<frame_slot, frames_in_flight> slots_;
+      std::deque<frame_timing> history_;
+      std::int64_t frame_ = 0;
+      std::int64_t dropped_ = 0;
+      int depth_ = 0;
+      bool recording_ = false;
+      mutable std::mutex mutex_;
+
+      frame_slot& current_slot() noexcept
+      {
+         return slots_[frame_ % frames_in_flight];
+      }
+
+      void end_scope(std::int64_t const frame, int const index)
+      {
+         // The frame that the scope was opened in has ended, and its slot may already be reused.
+         if (frame != frame_)
+            return;
+
+         close_scope(current_slot(), gsl::narrow_cast<std::size_t>(index));
+         --depth_;
+      }
+
+      static void close_scope(frame_slot& slot, std::size_t const index)
+      {
+         gl::QueryCounter(slot.queries[index][1], gl::TIMESTAMP);
+         slot.scopes[index].cpu_end = now();
+         slot.scopes[index].open = false;
+      }
+
+      void collect(frame_slot const& slot)
+      {
+         // Queries complete in submission order, so the frame's final timestamp being available
+         // means that every scope's timestamps are too.
+         auto available = GLint{gl::FALSE_};
+         gl::GetQueryObjectiv(slot.frame_queries[1], gl::QUERY_RESULT_AVAILABLE, &available);
+         if (available == gl::FALSE_) {
+            ++dropped_;
+            return;
+         }
+
+         auto result = frame_timing{slot.frame, slot.cpu_end - slot.cpu_begin,
+            elapsed(slot.frame_queries), {}};
+         result.scopes.reserve(ranges::size(slot.scopes));
+         for (auto i = decltype(ranges::size(slot.scopes)){0}; i < ranges::size(slot.scopes); ++i) {
+            auto const& s = slot.scopes[i];
+            result.scopes.push_back({s.name, s.depth, s.cpu_end - s.cpu_begin,
+               elapsed(slot.queries[i])});
+         }
+
+         auto const lock = std::lock_guard{mutex_};
+         if (ranges::size(history_) == history_size)
+            history_.pop_front();
+         history_.push_back(std::move(result));
+      }
+
+      template <typename F>
+      timing_statistics statistics_if(F const& f) const
+      {
+         auto cpu = std::vector<double>{};
+         auto gpu = std::vector<double>{};
+         {
+            auto const lock = std::lock_guard{mutex_};
+            for (auto const& frame : history_) {
+               if (auto const sample = f(frame)) {
+                  cpu.push_back(sample->first);
+                  gpu.push_back(sample->second);
+               }
+            }
+         }
+
+         return {percentiles_of(std::move(cpu)), percentiles_of(std::move(gpu))};
+      }
+
+      static percentiles percentiles_of(std::vector<double> samples)
+      {
+         if (ranges::empty(samples))
+            return {};
+
+         ranges::sort(samples);
+         auto const nearest_rank = [&samples](double const p) {
+            auto const n = ranges::size(samples);
+            auto const rank = static_cast<std::size_t>(p * static_cast<double>(n - 1) + 0.5);
+            return samples[rank];
+         };
+         return {nearest_rank(0.50), nearest_rank(0.95), nearest_rank(0.99)};
+      }
+
+      static double elapsed(query_pair const& queries) noexcept
+      {
+         auto begin = GLuint64{};
+         auto end = GLuint64{};
+         gl::GetQueryObjectui64v(queries[0], gl::QUERY_RESULT, &begin);
+         gl::GetQueryObjectui64v(queries[1], gl::QUERY_RESULT, &end);
+         return static_cast<double>(end - begin) * 1.0e-9;
+      }
+
+      static double now() noexcept
+      {
+         using seconds = std::chrono::duration<double>;
+         return seconds{std::chrono::steady_clock::now().time_since_epoch()}.count();
+      }
+   };
+} // namespace doge
+
+#endif // DOGE_UTILITY_PROFILER_HPP
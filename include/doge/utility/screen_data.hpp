@@ -16,15 +16,29 @@
 #ifndef DOGE_UTILITY_SCREEN_DATA_HPP
 #define DOGE_UTILITY_SCREEN_DATA_HPP
 
+#include <cstdlib>
+#include <doge/gl/gl_error.hpp>
+#include <doge/gl/memory.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <doge/utility/headless_context.hpp>
 #include <gl/gl_core.hpp>
 #include <GLFW/glfw3.h>
 #include <gsl/gsl>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 namespace doge {
    class screen_data {
    public:
-      enum class backend_t { gl, vulkan };
+      /// @brief Determines how the screen is presented.
+      /// @note backend_t::headless renders into an offscreen framebuffer without opening a window.
+      ///    It is selected by default when the DOGE_HEADLESS environment variable is set to
+      ///    anything other than 0, and DOGE_HEADLESS_FRAMES may be used to close the screen after
+      ///    a fixed number of frames.
+      ///
+      enum class backend_t { gl, vulkan, headless };
 
       screen_data() = default;
 
@@ -77,19 +91,62 @@ namespace doge {
          window_ = make_window_impl();
       }
 
+      constexpr bool headless() const noexcept
+      {
+         return backend_ == backend_t::headless;
+      }
+
       bool open() noexcept
       {
-         return not glfwWindowShouldClose(window());
+         return headless() ? not closed_ : not glfwWindowShouldClose(window());
       }
 
       void close() noexcept
       {
-         glfwSetWindowShouldClose(window(), true);
+         if (headless())
+            closed_ = true;
+         else
+            glfwSetWindowShouldClose(window(), true);
       }
 
       void swap_buffers() noexcept
       {
-         glfwSwapBuffers(window());
+         if (headless()) {
+            // There's nothing to present, but waiting for the frame keeps the CPU from racing
+            // ahead of the GPU the same way that a swap would.
+            gl::Finish();
+            if (++frames_ == frame_limit_)
+               close();
+         }
+         else {
+            glfwSwapBuffers(window());
+         }
+      }
+
+      void poll_events() noexcept
+      {
+         if (not headless())
+            glfwPollEvents();
+      }
+
+      /// @brief Binds the GL context to the calling thread.
+      ///
+      void make_context_current() noexcept
+      {
+         if (headless())
+            headless_->make_current();
+         else
+            glfwMakeContextCurrent(window());
+      }
+
+      /// @brief Unbinds the GL context from the calling thread, so that another thread may bind it.
+      ///
+      void release_context() noexcept
+      {
+         if (headless())
+            headless_->release();
+         else
+            glfwMakeContextCurrent(nullptr);
       }
 
       float aspect_ratio() const noexcept
@@ -97,48 +154,79 @@ namespace doge {
          return aspect_ratio_;
       }
    private:
-      backend_t backend_ = backend_t::gl;
+      backend_t backend_ = default_backend();
       int width_ = 1920;
       int height_ = 1080;
       float aspect_ratio_ = set_aspect_ratio();
       int antialiasing_ = 4;
       bool fullscreen_ = false;
-      std::unique_ptr<GLFWmonitor, void(*)(void*)> monitor_ = []{
-         if (not glfwInit())
-            throw std::runtime_error{"Unable to initialise GLFW3"};
-         return std::unique_ptr<GLFWmonitor, void(*)(void*)>{glfwGetPrimaryMonitor(),
-            [](void*){ glfwTerminate(); }};
-      }();
-      const GLFWvidmode* vidmode_ = glfwGetVideoMode(monitor_.get());
+      std::unique_ptr<GLFWmonitor, void(*)(void*)> monitor_ = make_monitor();
+      const GLFWvidmode* vidmode_ = monitor_ ? glfwGetVideoMode(monitor_.get()) : nullptr;
+      std::unique_ptr<headless_context> headless_ = headless()
+         ? std::make_unique<headless_context>(width_, height_) : nullptr;
       std::unique_ptr<GLFWwindow, void(*)(GLFWwindow*)> window_ = make_window_impl();
+      int frame_limit_ = environment_integer("DOGE_HEADLESS_FRAMES");
+      int frames_ = 0;
+      bool closed_ = false;
+
+      static int environment_integer(char const* const name) noexcept
+      {
+         auto const* const value = std::getenv(name);
+         return value != nullptr ? std::atoi(value) : 0;
+      }
+
+      static backend_t default_backend() noexcept
+      {
+         auto const* const value = std::getenv("DOGE_HEADLESS");
+         return value != nullptr && *value != '\0' && std::string_view{value} != "0"
+            ? backend_t::headless : backend_t::gl;
+      }
 
       float set_aspect_ratio() const noexcept
       {
          return gsl::narrow_cast<float>(width_) / gsl::narrow_cast<float>(height_);
       }
 
+      std::unique_ptr<GLFWmonitor, void(*)(void*)> make_monitor() const
+      {
+         if (headless())
+            return {nullptr, [](void*){}};
+
+         if (not glfwInit())
+            throw std::runtime_error{"Unable to initialise GLFW3"};
+         return std::unique_ptr<GLFWmonitor, void(*)(void*)>{glfwGetPrimaryMonitor(),
+            [](void*){ glfwTerminate(); }};
+      }
+
       std::unique_ptr<GLFWwindow, void(*)(GLFWwindow*)> make_window_impl()
       {
+         if (headless())
+            return {nullptr, [](GLFWwindow*){}};
+
          if (backend_ == backend_t::gl) {
             glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
             glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
             glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
             glfwWindowHint(GLFW_SAMPLES, antialiasing_);
+            glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT,
+               default_error_policy == error_policy::debug_output);
          }
 
          auto w = std::unique_ptr<GLFWwindow, void(*)(GLFWwindow*)>{
             glfwCreateWindow(width_, height_, "doge", fullscreen_ ? monitor_.get() : nullptr, nullptr),
             [](GLFWwindow* p){ if (p) glfwDestroyWindow(p); }};
-         glfwMakeContextCurrent(window_.get());
-         glfwSetFramebufferSizeCallback(window_.get(), screen_data::framebuffer_size_callback);
-         if (auto gl_load_gen = gl::sys::LoadFunctions(); not (window_ || gl_load_gen))
+         glfwMakeContextCurrent(w.get());
+         glfwSetFramebufferSizeCallback(w.get(), screen_data::framebuffer_size_callback);
+         if (auto gl_load_gen = gl::sys::LoadFunctions(); not (w && gl_load_gen))
             throw std::runtime_error{"Could not open window with glfw3."};
+
+         forget_pooled_names();
          return w;
       }
 
       static void framebuffer_size_callback(GLFWwindow*, const int width, const int height) noexcept
       {
-         gl::Viewport(0, 0, width, height);
+         state_cache::viewport(0, 0, width, height);
       }
    };
 }
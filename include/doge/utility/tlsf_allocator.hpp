@@ -0,0 +1,125 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DOGE_UTILITY_TLSF_ALLOCATOR_HPP
+#define DOGE_UTILITY_TLSF_ALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace doge {
+   /// @brief Hands out ranges of an address space that it doesn't own, such as the bytes of a GPU
+   ///    buffer, using two-level segregated fits.
+   ///
+   /// Free ranges are binned by size: the first level is the position of the size's highest set
+   /// bit, and the second level splits each power of two into sixteen. A bitmap of the non-empty
+   /// bins finds a free range that's big enough in constant time, and freed ranges are merged with
+   /// their free neighbours straight away, so fragmentation stays low without any compaction.
+   ///
+   /// The allocator only does bookkeeping: nothing is read or written at the offsets it returns.
+   ///
+   class tlsf_allocator {
+   public:
+      /// @brief A range that has been handed out. It's returned to the allocator by passing it to
+      ///    deallocate().
+      ///
+      struct allocation {
+         std::size_t offset = 0;
+         std::size_t size = 0;
+         std::uint32_t node = std::numeric_limits<std::uint32_t>::max();
+      };
+
+      explicit tlsf_allocator(std::size_t capacity = 0);
+
+      /// @brief Finds size units whose offset is a multiple of alignment.
+      /// @returns std::nullopt if no free range is big enough.
+      /// @note alignment doesn't need to be a power of two, so it can be a vertex's size.
+      ///
+      [[nodiscard]] std::optional<allocation> allocate(std::size_t size,
+         std::size_t alignment = 1);
+
+      /// @brief Returns a range that was handed out by allocate().
+      ///
+      void deallocate(allocation const& a) noexcept;
+
+      /// @brief Extends the address space to capacity units. Ranges that have been handed out keep
+      ///    their offsets.
+      ///
+      void grow(std::size_t capacity);
+
+      /// @brief The size of the address space.
+      ///
+      [[nodiscard]] std::size_t capacity() const noexcept
+      {
+         return capacity_;
+      }
+
+      /// @brief The number of units that haven't been handed out.
+      ///
+      [[nodiscard]] std::size_t available() const noexcept
+      {
+         return available_;
+      }
+   private:
+      static constexpr auto no_node = std::numeric_limits<std::uint32_t>::max();
+      static constexpr int second_level_bits = 4;
+      static constexpr std::size_t second_level_count = std::size_t{1} << second_level_bits;
+      static constexpr std::size_t first_level_count = 64 - second_level_bits + 1;
+
+      struct node {
+         std::size_t offset = 0;
+         std::size_t size = 0;
+
+         // The neighbouring free nodes in the same bin. Released nodes are chained through
+         // next_free instead.
+         std::uint32_t previous_free = no_node;
+         std::uint32_t next_free = no_node;
+
+         // The nodes that cover the ranges immediately before and after this one.
+         std::uint32_t previous = no_node;
+         std::uint32_t next = no_node;
+
+         bool used = false;
+      };
+
+      std::vector<node> nodes_;
+      std::uint32_t released_ = no_node;
+      std::uint64_t first_level_bitmap_ = 0;
+      std::array<std::uint16_t, first_level_count> second_level_bitmaps_ = {};
+      std::array<std::uint32_t, first_level_count * second_level_count> bins_;
+      std::uint32_t last_ = no_node;
+      std::size_t capacity_ = 0;
+      std::size_t available_ = 0;
+
+      static std::size_t bin_of(std::size_t size) noexcept;
+      static std::size_t search_bin_of(std::size_t size) noexcept;
+
+      std::uint32_t make_node(std::size_t offset, std::size_t size);
+      void release_node(std::uint32_t n) noexcept;
+
+      void insert_free(std::uint32_t n) noexcept;
+      void remove_free(std::uint32_t n) noexcept;
+      std::uint32_t find_free(std::size_t size) const noexcept;
+
+      // Joins n's successor onto n, and releases the successor.
+      void absorb_next(std::uint32_t n) noexcept;
+   };
+} // namespace doge
+
+#endif // DOGE_UTILITY_TLSF_ALLOCATOR_HPP
@@ -0,0 +1,115 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <doge/gl/program_reflection.hpp>
+#include <array>
+#include <gsl/gsl>
+#include <stdexcept>
+#include <string>
+
+namespace {
+   namespace ranges = std::experimental::ranges;
+
+   struct resource {
+      std::string name;
+      std::array<GLint, 4> properties;
+   };
+
+   // Calls f with the name and requested properties of each of program's active resources of kind
+   // interface.
+   template <std::size_t N, ranges::Invocable<resource const&> F>
+   void for_each_resource(GLuint const program, GLenum const interface,
+      std::array<GLenum, N> const& properties, F const& f)
+   {
+      static_assert(N <= 4);
+
+      auto count = GLint{0};
+      gl::GetProgramInterfaceiv(program, interface, gl::ACTIVE_RESOURCES, &count);
+      auto max_length = GLint{0};
+      gl::GetProgramInterfaceiv(program, interface, gl::MAX_NAME_LENGTH, &max_length);
+
+      auto r = resource{std::string(max_length, '\0'), {}};
+      for (auto i = GLuint{0}; i < static_cast<GLuint>(count); ++i) {
+         auto length = GLsizei{0};
+         r.name.resize(max_length);
+         gl::GetProgramResourceName(program, interface, i, max_length, &length, r.name.data());
+         r.name.resize(length);
+         gl::GetProgramResourceiv(program, interface, i, N, properties.data(), N, nullptr,
+            r.properties.data());
+         ranges::invoke(f, r);
+      }
+   }
+
+   template <typename T>
+   void insert(doge::detail::reflection_table<T>& table, std::string_view const name,
+      T const& value)
+   {
+      if (not table.insert(doge::resource_name::hash(name), value))
+         throw std::runtime_error{"program resource name hashes collide: " + std::string{name}};
+   }
+} // namespace <anonymous>
+
+namespace doge {
+   program_reflection::program_reflection(GLuint const program)
+   {
+      constexpr auto variable_properties = std::array<GLenum, 3>{gl::LOCATION, gl::TYPE,
+         gl::ARRAY_SIZE};
+
+      for_each_resource(program, gl::UNIFORM, variable_properties, [this](resource const& r) {
+         // Uniforms in blocks don't have locations: they're reached through their block.
+         auto const location = r.properties[0];
+         if (location < 0)
+            return;
+
+         auto const type = gsl::narrow_cast<GLenum>(r.properties[1]);
+         auto const array_size = r.properties[2];
+
+         // Arrays are reported as name[0], but may also be looked up as name, or as name[i] for
+         // any element.
+         auto const subscript = r.name.rfind("[0]");
+         if (subscript == std::string::npos || subscript + 3 != r.name.size()) {
+            insert(uniforms_, r.name, {location, type, array_size});
+            return;
+         }
+
+         auto const base = r.name.substr(0, subscript);
+         insert(uniforms_, base, {location, type, array_size});
+         for (auto i = 0; i < array_size; ++i) {
+            insert(uniforms_, base + '[' + std::to_string(i) + ']',
+               {location + i, type, array_size - i});
+         }
+      });
+
+      for_each_resource(program, gl::PROGRAM_INPUT, variable_properties,
+         [this](resource const& r) {
+            insert(attributes_, r.name, {r.properties[0],
+               gsl::narrow_cast<GLenum>(r.properties[1]), r.properties[2]});
+         });
+
+      constexpr auto block_properties = std::array<GLenum, 2>{gl::BUFFER_BINDING,
+         gl::BUFFER_DATA_SIZE};
+      auto index = GLuint{0};
+      for_each_resource(program, gl::UNIFORM_BLOCK, block_properties,
+         [this, &index](resource const& r) {
+            insert(uniform_blocks_, r.name, {index++, r.properties[0], r.properties[1]});
+         });
+
+      index = 0;
+      for_each_resource(program, gl::SHADER_STORAGE_BLOCK, block_properties,
+         [this, &index](resource const& r) {
+            insert(storage_blocks_, r.name, {index++, r.properties[0], r.properties[1]});
+         });
+   }
+} // namespace doge
@@ -18,6 +18,8 @@ namespace doge {
          gl::GetProgramInfoLog(index_, log.size(), nullptr, log.data());
          throw std::runtime_error{log};
       }
+
+      reflection_ = program_reflection{index_};
    }
 
    vector<shader_source>
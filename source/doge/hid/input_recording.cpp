@@ -0,0 +1,241 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <doge/hid/input_recording.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/iterator>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+   namespace ranges = std::experimental::ranges;
+   using doge::hid::input_event;
+
+   // The file begins with a magic number and a version, and every record begins with a tag. All
+   // integers and floats are stored little-endian, whatever the host's byte order.
+   constexpr auto magic = std::array<char, 8>{'d', 'o', 'g', 'e', 'i', 'n', 'p', 't'};
+   constexpr auto version = std::uint8_t{1};
+
+   enum class tag : std::uint8_t { frame, keyboard, mouse_button, cursor, scroll };
+
+   void write_unsigned(std::ofstream& out, std::uint64_t value, int const bytes)
+   {
+      for (auto i = 0; i < bytes; ++i, value >>= 8)
+         out.put(static_cast<char>(value & 0xff));
+   }
+
+   void write_float(std::ofstream& out, float const value)
+   {
+      auto bits = std::uint32_t{};
+      std::memcpy(&bits, &value, sizeof(bits));
+      write_unsigned(out, bits, sizeof(bits));
+   }
+
+   void write_double(std::ofstream& out, double const value)
+   {
+      auto bits = std::uint64_t{};
+      std::memcpy(&bits, &value, sizeof(bits));
+      write_unsigned(out, bits, sizeof(bits));
+   }
+
+   class reader {
+   public:
+      explicit reader(std::vector<char> bytes) noexcept
+         : bytes_{std::move(bytes)}
+      {}
+
+      bool done() const noexcept
+      {
+         return position_ == ranges::size(bytes_);
+      }
+
+      std::uint64_t read_unsigned(int const bytes)
+      {
+         if (ranges::size(bytes_) - position_ < static_cast<std::size_t>(bytes))
+            throw std::runtime_error{"Input recording is truncated."};
+
+         auto value = std::uint64_t{};
+         for (auto i = 0; i < bytes; ++i)
+            value |= std::uint64_t{static_cast<unsigned char>(bytes_[position_++])} << (8 * i);
+         return value;
+      }
+
+      float read_float()
+      {
+         auto const bits = static_cast<std::uint32_t>(read_unsigned(sizeof(float)));
+         auto value = 0.0f;
+         std::memcpy(&value, &bits, sizeof(value));
+         return value;
+      }
+
+      double read_double()
+      {
+         auto const bits = read_unsigned(sizeof(double));
+         auto value = 0.0;
+         std::memcpy(&value, &bits, sizeof(value));
+         return value;
+      }
+   private:
+      std::vector<char> bytes_;
+      std::size_t position_ = 0;
+   };
+
+   input_event read_button(reader& in, input_event::device const source)
+   {
+      auto e = input_event{source};
+      e.code = static_cast<std::int16_t>(in.read_unsigned(2));
+      e.action = static_cast<int>(in.read_unsigned(1));
+      e.mods = static_cast<int>(in.read_unsigned(1));
+
+      // The code indexes the key and button states directly when the event is replayed.
+      if (source == input_event::device::keyboard ? not doge::hid::keyboard::valid_key(e.code)
+                                                  : not doge::hid::mouse::valid_button(e.code)) {
+         throw std::runtime_error{"Input recording contains a key or button that doesn't exist."};
+      }
+
+      return e;
+   }
+
+   input_event read_position(reader& in, input_event::device const source)
+   {
+      auto e = input_event{source};
+      e.position.x = in.read_float();
+      e.position.y = in.read_float();
+      return e;
+   }
+
+   std::vector<char> read_file(std::string const& path)
+   {
+      if (auto in = std::ifstream{path, std::ios::binary})
+         return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+      throw std::runtime_error{"Unable to open file " + path};
+   }
+} // namespace <anonymous>
+
+namespace doge::hid {
+   input_recorder::input_recorder(std::string const& path)
+      : out_{path, std::ios::binary}
+   {
+      if (not out_)
+         throw std::runtime_error{"Unable to open file " + path};
+
+      out_.write(ranges::data(magic), ranges::size(magic));
+      out_.put(static_cast<char>(version));
+      hid::observe(record, this);
+   }
+
+   input_recorder::~input_recorder()
+   {
+      hid::observe(nullptr);
+   }
+
+   void input_recorder::frame(double const displacement)
+   {
+      out_.put(static_cast<char>(tag::frame));
+      write_double(out_, displacement);
+   }
+
+   void input_recorder::record(input_event const& e, void* const recorder) noexcept
+   {
+      auto& out = static_cast<input_recorder*>(recorder)->out_;
+      switch (e.source) {
+      case input_event::device::keyboard:
+      case input_event::device::mouse_button:
+         out.put(static_cast<char>(e.source == input_event::device::keyboard ? tag::keyboard
+                                                                              : tag::mouse_button));
+         write_unsigned(out, static_cast<std::uint16_t>(e.code), 2);
+         write_unsigned(out, static_cast<std::uint8_t>(e.action), 1);
+         write_unsigned(out, static_cast<std::uint8_t>(e.mods), 1);
+         break;
+      case input_event::device::cursor:
+      case input_event::device::scroll:
+         out.put(static_cast<char>(e.source == input_event::device::cursor ? tag::cursor
+                                                                            : tag::scroll));
+         write_float(out, e.position.x);
+         write_float(out, e.position.y);
+         break;
+      }
+   }
+
+   input_player::input_player(std::string const& path)
+   {
+      auto in = reader{read_file(path)};
+      for (auto const c : magic) {
+         if (in.done() || static_cast<char>(in.read_unsigned(1)) != c)
+            throw std::runtime_error{path + " is not an input recording."};
+      }
+
+      if (in.read_unsigned(1) != version)
+         throw std::runtime_error{path + " was recorded by an incompatible version of doge."};
+
+      while (not in.done()) {
+         switch (static_cast<tag>(in.read_unsigned(1))) {
+         case tag::frame:
+            frames_.push_back({in.read_double(), ranges::size(events_)});
+            break;
+         case tag::keyboard:
+            events_.push_back(read_button(in, input_event::device::keyboard));
+            break;
+         case tag::mouse_button:
+            events_.push_back(read_button(in, input_event::device::mouse_button));
+            break;
+         case tag::cursor:
+            events_.push_back(read_position(in, input_event::device::cursor));
+            break;
+         case tag::scroll:
+            events_.push_back(read_position(in, input_event::device::scroll));
+            break;
+         default:
+            throw std::runtime_error{path + " contains an unknown record."};
+         }
+      }
+
+      hid::live(false);
+   }
+
+   input_player::~input_player()
+   {
+      hid::live(true);
+   }
+
+   std::optional<double> input_player::next_frame() noexcept
+   {
+      if (next_frame_ == ranges::size(frames_)) {
+         apply_until(ranges::size(events_));
+         return std::nullopt;
+      }
+
+      // Catches up on events that weren't polled, such as any recorded before play started.
+      auto const& frame = frames_[next_frame_++];
+      apply_until(frame.first_event);
+      return frame.displacement;
+   }
+
+   void input_player::poll_events() noexcept
+   {
+      apply_until(next_frame_ < ranges::size(frames_) ? frames_[next_frame_].first_event
+                                                      : ranges::size(events_));
+   }
+
+   void input_player::apply_until(std::size_t const last) noexcept
+   {
+      for (; next_event_ < last; ++next_event_)
+         apply(events_[next_event_]);
+   }
+} // namespace doge::hid
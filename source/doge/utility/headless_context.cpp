@@ -0,0 +1,186 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <doge/utility/headless_context.hpp>
+#include <doge/gl/gl_error.hpp>
+#include <doge/gl/memory.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+   bool has_extension(EGLDisplay const display, char const* const name) noexcept
+   {
+      auto const* const extensions = eglQueryString(display, EGL_EXTENSIONS);
+      return extensions != nullptr && std::strstr(extensions, name) != nullptr;
+   }
+
+   EGLDisplay open_display()
+   {
+      if (has_extension(EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless")) {
+         auto const get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+         if (get_platform_display != nullptr) {
+            if (auto const display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA,
+                  EGL_DEFAULT_DISPLAY, nullptr); display != EGL_NO_DISPLAY) {
+               return display;
+            }
+         }
+      }
+
+      return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+   }
+
+   [[noreturn]] void egl_error(std::string const& what)
+   {
+      throw std::runtime_error{"Unable to create a headless context: " + what + " (EGL error "
+         + std::to_string(eglGetError()) + ")"};
+   }
+} // namespace <anonymous>
+
+namespace doge {
+   headless_context::headless_context(int const width, int const height)
+   {
+      // The destructor won't run if the constructor throws, so whatever has been created by then
+      // is cleaned up here.
+      try {
+         create(width, height);
+      }
+      catch (...) {
+         destroy();
+         throw;
+      }
+   }
+
+   headless_context::~headless_context()
+   {
+      destroy();
+   }
+
+   void headless_context::make_current() noexcept
+   {
+      eglMakeCurrent(display_, surface_, surface_, context_);
+   }
+
+   void headless_context::release() noexcept
+   {
+      eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+   }
+
+   void headless_context::create(int const width, int const height)
+   {
+      display_ = open_display();
+      if (display_ == EGL_NO_DISPLAY || not eglInitialize(display_, nullptr, nullptr))
+         egl_error("no EGL display");
+
+      if (not eglBindAPI(EGL_OPENGL_API))
+         egl_error("EGL can't create desktop OpenGL contexts");
+
+      EGLint const config_attributes[] = {
+         EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+         EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+         EGL_RED_SIZE, 8,
+         EGL_GREEN_SIZE, 8,
+         EGL_BLUE_SIZE, 8,
+         EGL_ALPHA_SIZE, 8,
+         EGL_DEPTH_SIZE, 24,
+         EGL_NONE
+      };
+
+      auto config = EGLConfig{};
+      auto configs = EGLint{0};
+      if (not eglChooseConfig(display_, config_attributes, &config, 1, &configs) || configs == 0)
+         egl_error("no suitable framebuffer configuration");
+
+      // Like the windowed backend, ask for a debug context when errors are reported through debug
+      // output. EGL_CONTEXT_OPENGL_DEBUG is new in EGL 1.5, so older displays get a plain context,
+      // and error_checking falls back to per_frame if that can't provide debug output.
+      auto const create_context = [this, config](bool const debug) {
+         EGLint const context_attributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_CONTEXT_OPENGL_DEBUG, debug ? EGL_TRUE : EGL_FALSE,
+            EGL_NONE
+         };
+         return eglCreateContext(display_, config, EGL_NO_CONTEXT, context_attributes);
+      };
+
+      constexpr auto debug = default_error_policy == error_policy::debug_output;
+      context_ = create_context(debug);
+      if (context_ == EGL_NO_CONTEXT && debug)
+         context_ = create_context(false);
+      if (context_ == EGL_NO_CONTEXT)
+         egl_error("unable to create an OpenGL 4.3 core context");
+
+      if (not has_extension(display_, "EGL_KHR_surfaceless_context")) {
+         EGLint const surface_attributes[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+         surface_ = eglCreatePbufferSurface(display_, config, surface_attributes);
+         if (surface_ == EGL_NO_SURFACE)
+            egl_error("unable to create a pbuffer surface");
+      }
+
+      make_current();
+      if (eglGetCurrentContext() != context_)
+         egl_error("unable to make the context current");
+
+      if (auto const gl_load_gen = gl::sys::LoadFunctions(); not gl_load_gen)
+         throw std::runtime_error{"Unable to load OpenGL functions for the headless context."};
+
+      gl::GenRenderbuffers(1, &colour_);
+      gl::BindRenderbuffer(gl::RENDERBUFFER, colour_);
+      gl::RenderbufferStorage(gl::RENDERBUFFER, gl::RGBA8, width, height);
+
+      gl::GenRenderbuffers(1, &depth_stencil_);
+      gl::BindRenderbuffer(gl::RENDERBUFFER, depth_stencil_);
+      gl::RenderbufferStorage(gl::RENDERBUFFER, gl::DEPTH24_STENCIL8, width, height);
+
+      gl::GenFramebuffers(1, &framebuffer_);
+      gl::BindFramebuffer(gl::FRAMEBUFFER, framebuffer_);
+      gl::FramebufferRenderbuffer(gl::FRAMEBUFFER, gl::COLOR_ATTACHMENT0, gl::RENDERBUFFER, colour_);
+      gl::FramebufferRenderbuffer(gl::FRAMEBUFFER, gl::DEPTH_STENCIL_ATTACHMENT, gl::RENDERBUFFER,
+         depth_stencil_);
+
+      if (gl::CheckFramebufferStatus(gl::FRAMEBUFFER) != gl::FRAMEBUFFER_COMPLETE)
+         throw std::runtime_error{"The headless framebuffer is incomplete."};
+
+      state_cache::invalidate();
+      forget_pooled_names();
+      state_cache::viewport(0, 0, width, height);
+   }
+
+   void headless_context::destroy() noexcept
+   {
+      // The renderbuffers are only created once the GL functions have been loaded.
+      if (colour_ != 0 && eglGetCurrentContext() == context_) {
+         gl::DeleteFramebuffers(1, &framebuffer_);
+         gl::DeleteRenderbuffers(1, &depth_stencil_);
+         gl::DeleteRenderbuffers(1, &colour_);
+      }
+
+      if (display_ == EGL_NO_DISPLAY)
+         return;
+
+      release();
+      if (surface_ != EGL_NO_SURFACE)
+         eglDestroySurface(display_, surface_);
+      if (context_ != EGL_NO_CONTEXT)
+         eglDestroyContext(display_, context_);
+      eglTerminate(display_);
+   }
+} // namespace doge
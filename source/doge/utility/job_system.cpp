@@ -0,0 +1,173 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <doge/utility/job_system.hpp>
+#include <experimental/ranges/concepts>
+#include <experimental/ranges/iterator>
+
+namespace {
+   // Identifies the queue that the current thread owns, so that a thread which spawns a job pushes
+   // it onto its own deque.
+   thread_local doge::job_system const* current_system = nullptr;
+   thread_local std::size_t current_queue = 0;
+} // namespace <anonymous>
+
+namespace doge {
+   job_system::job_system(int const workers)
+   {
+      Expects(workers >= 0);
+      for (auto i = 0; i <= workers; ++i)
+         queues_.push_back(std::make_unique<worker_queue>());
+
+      workers_.reserve(workers);
+      for (auto i = 1; i <= workers; ++i)
+         workers_.emplace_back([this, i]{ work(gsl::narrow_cast<std::size_t>(i)); });
+   }
+
+   job_system::~job_system()
+   {
+      wait_for_frame();
+      {
+         auto const lock = std::lock_guard{sleep_mutex_};
+         stopping_ = true;
+      }
+      wake_.notify_all();
+
+      for (auto& worker : workers_)
+         worker.join();
+   }
+
+   void job_system::wait(job_handle const& job)
+   {
+      auto const self = queue_index();
+      while (not job.done()) {
+         if (not run_one(self))
+            std::this_thread::yield();
+      }
+   }
+
+   void job_system::wait_for_frame()
+   {
+      auto const self = queue_index();
+      while (outstanding_.load(std::memory_order_acquire) != 0) {
+         if (not run_one(self))
+            std::this_thread::yield();
+      }
+   }
+
+   void job_system::push(job j)
+   {
+      outstanding_.fetch_add(1, std::memory_order_relaxed);
+      schedule(std::move(j));
+   }
+
+   void job_system::schedule(job j)
+   {
+      auto& queue = *queues_[queue_index()];
+      {
+         auto const lock = std::lock_guard{queue.mutex};
+         queue.jobs.push_back(std::move(j));
+      }
+      queued_.fetch_add(1, std::memory_order_release);
+
+      // Taking the lock orders this notification after a sleeping worker's last look at queued_.
+      { auto const lock = std::lock_guard{sleep_mutex_}; }
+      wake_.notify_one();
+   }
+
+   bool job_system::run_one(std::size_t const self) noexcept
+   {
+      auto j = job{};
+      if (not try_pop(self, j))
+         return false;
+
+      execute(j);
+      return true;
+   }
+
+   bool job_system::try_pop(std::size_t const self, job& result) noexcept
+   {
+      if (queued_.load(std::memory_order_acquire) == 0)
+         return false;
+
+      // Newest first from our own deque, since its data is most likely to still be in cache...
+      {
+         auto& queue = *queues_[self];
+         auto const lock = std::lock_guard{queue.mutex};
+         if (not ranges::empty(queue.jobs)) {
+            result = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+         }
+      }
+
+      // ...and oldest first from everyone else's, since older jobs tend to be bigger.
+      auto const queues = ranges::size(queues_);
+      for (auto i = decltype(queues){1}; i < queues; ++i) {
+         auto& victim = *queues_[(self + i) % queues];
+         auto const lock = std::lock_guard{victim.mutex};
+         if (not ranges::empty(victim.jobs)) {
+            result = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   void job_system::execute(job& j) noexcept
+   {
+      ranges::invoke(j.work);
+
+      if (j.state->unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+         auto continuations = [&state = *j.state]{
+            auto const lock = std::lock_guard{state.mutex};
+            return std::move(state.continuations);
+         }();
+
+         for (auto& continuation : continuations)
+            schedule(std::move(continuation));
+      }
+
+      outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+   }
+
+   void job_system::work(std::size_t const self) noexcept
+   {
+      current_system = this;
+      current_queue = self;
+
+      while (true) {
+         if (run_one(self))
+            continue;
+
+         auto lock = std::unique_lock{sleep_mutex_};
+         wake_.wait(lock, [this]{
+            return stopping_.load() || queued_.load(std::memory_order_acquire) != 0;
+         });
+
+         if (stopping_)
+            return;
+      }
+   }
+
+   std::size_t job_system::queue_index() const noexcept
+   {
+      return current_system == this ? current_queue : 0;
+   }
+} // namespace doge
@@ -0,0 +1,461 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <doge/utility/mesh_optimisation.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <experimental/ranges/algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+   namespace ranges = std::experimental::ranges;
+
+   constexpr auto none = std::numeric_limits<GLuint>::max();
+
+   std::uint64_t hash_bytes(std::byte const* const first, std::size_t const size) noexcept
+   {
+      auto hash = std::uint64_t{14695981039346656037u};
+      for (auto i = std::size_t{0}; i < size; ++i)
+         hash = (hash ^ std::to_integer<std::uint64_t>(first[i])) * 1099511628211u;
+      return hash;
+   }
+
+   // The triangles that use each vertex, stored as one list, with each vertex's triangles
+   // starting at offsets[v].
+   struct adjacency {
+      std::vector<GLuint> offsets;
+      std::vector<GLuint> triangles;
+
+      adjacency(gsl::span<GLuint const> const elements, std::size_t const vertex_count)
+         : offsets(vertex_count + 1),
+           triangles(ranges::size(elements))
+      {
+         for (auto const v : elements)
+            ++offsets[v + 1];
+         for (auto v = std::size_t{1}; v < ranges::size(offsets); ++v)
+            offsets[v] += offsets[v - 1];
+
+         auto next = std::vector<GLuint>(ranges::begin(offsets), ranges::end(offsets) - 1);
+         for (auto i = std::ptrdiff_t{0}; i < ranges::size(elements); ++i)
+            triangles[next[elements[i]]++] = gsl::narrow_cast<GLuint>(i / 3);
+      }
+
+      gsl::span<GLuint const> of(GLuint const v) const noexcept
+      {
+         return {triangles.data() + offsets[v],
+            gsl::narrow_cast<std::ptrdiff_t>(offsets[v + 1] - offsets[v])};
+      }
+   };
+
+   using position = std::array<float, 3>;
+
+   std::array<double, 3> normal_of(position const& a, position const& b, position const& c) noexcept
+   {
+      auto const u = std::array<double, 3>{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      auto const v = std::array<double, 3>{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+      return {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+   }
+
+   double dot(std::array<double, 3> const& a, std::array<double, 3> const& b) noexcept
+   {
+      return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+   }
+
+   // The squared distances from a point to a set of planes, stored as the upper half of a
+   // symmetric 4x4 matrix (Garland and Heckbert, 1997). Each plane is weighted by the area of its
+   // triangle, and the error is the weighted mean, so that it doesn't grow with the number of
+   // triangles that have been merged.
+   struct quadric {
+      double a2 = 0.0, b2 = 0.0, c2 = 0.0, d2 = 0.0;
+      double ab = 0.0, ac = 0.0, ad = 0.0, bc = 0.0, bd = 0.0, cd = 0.0;
+      double weight = 0.0;
+
+      static quadric of_triangle(position const& p0, position const& p1,
+         position const& p2) noexcept
+      {
+         auto n = normal_of(p0, p1, p2);
+         auto const length = std::sqrt(dot(n, n));
+         if (length == 0.0)
+            return {};
+
+         for (auto& x : n)
+            x /= length;
+         auto const d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+
+         auto const area = length / 2.0;
+         auto result = quadric{};
+         result.a2 = area * n[0] * n[0];
+         result.b2 = area * n[1] * n[1];
+         result.c2 = area * n[2] * n[2];
+         result.d2 = area * d * d;
+         result.ab = area * n[0] * n[1];
+         result.ac = area * n[0] * n[2];
+         result.ad = area * n[0] * d;
+         result.bc = area * n[1] * n[2];
+         result.bd = area * n[1] * d;
+         result.cd = area * n[2] * d;
+         result.weight = area;
+         return result;
+      }
+
+      quadric& operator+=(quadric const& q) noexcept
+      {
+         a2 += q.a2; b2 += q.b2; c2 += q.c2; d2 += q.d2;
+         ab += q.ab; ac += q.ac; ad += q.ad; bc += q.bc; bd += q.bd; cd += q.cd;
+         weight += q.weight;
+         return *this;
+      }
+
+      double error(position const& p) const noexcept
+      {
+         if (weight == 0.0)
+            return 0.0;
+
+         auto const x = double{p[0]};
+         auto const y = double{p[1]};
+         auto const z = double{p[2]};
+         auto const result = a2 * x * x + b2 * y * y + c2 * z * z + d2
+                           + 2 * (ab * x * y + ac * x * z + ad * x + bc * y * z + bd * y + cd * z);
+
+         // Rounding can leave a point that's on every plane very slightly below zero.
+         return std::max(result / weight, 0.0);
+      }
+   };
+
+   // Finds the points that must stay where they are: those on a seam, where vertices with the same
+   // position have different attributes, and those on a border or a non-manifold edge.
+   std::vector<bool> locked_points(gsl::span<GLuint const> const elements,
+      gsl::span<GLuint const> const point, std::size_t const point_count)
+   {
+      auto result = std::vector<bool>(point_count);
+      auto first_vertex = std::vector<GLuint>(point_count, none);
+      for (auto const v : elements) {
+         auto const p = point[v];
+         if (first_vertex[p] == none)
+            first_vertex[p] = v;
+         else if (first_vertex[p] != v)
+            result[p] = true;
+      }
+
+      auto edges = std::unordered_map<std::uint64_t, int>{};
+      auto const edge_key = [](GLuint const a, GLuint const b) {
+         return std::uint64_t{std::min(a, b)} << 32 | std::max(a, b); };
+      for (auto i = std::ptrdiff_t{0}; i < ranges::size(elements); i += 3) {
+         for (auto corner = 0; corner < 3; ++corner) {
+            auto const a = point[elements[i + corner]];
+            auto const b = point[elements[i + (corner + 1) % 3]];
+            ++edges[edge_key(a, b)];
+         }
+      }
+
+      for (auto const [key, count] : edges) {
+         if (count != 2) {
+            result[gsl::narrow_cast<std::size_t>(key >> 32)] = true;
+            result[gsl::narrow_cast<std::size_t>(key & 0xffffffff)] = true;
+         }
+      }
+
+      return result;
+   }
+} // namespace <anonymous>
+
+namespace doge {
+   std::vector<GLuint> index_vertices(gsl::span<std::byte const> const vertices,
+      std::size_t const stride)
+   {
+      Expects(stride > 0);
+      Expects(ranges::size(vertices) % stride == 0);
+      auto const count = ranges::size(vertices) / stride;
+
+      // An open-addressed table of the first vertex with each value, at most half full.
+      auto buckets = std::size_t{1};
+      while (buckets < 2 * count)
+         buckets *= 2;
+      auto table = std::vector<GLuint>(buckets, none);
+
+      auto result = std::vector<GLuint>(count);
+      auto unique = GLuint{0};
+      auto const* const data = ranges::data(vertices);
+      for (auto i = std::size_t{0}; i < count; ++i) {
+         auto const* const vertex = data + i * stride;
+         auto slot = hash_bytes(vertex, stride) & (buckets - 1);
+         while (table[slot] != none
+            && std::memcmp(data + table[slot] * stride, vertex, stride) != 0) {
+            slot = (slot + 1) & (buckets - 1);
+         }
+
+         if (table[slot] == none) {
+            table[slot] = gsl::narrow_cast<GLuint>(i);
+            result[i] = unique++;
+         }
+         else {
+            result[i] = result[table[slot]];
+         }
+      }
+
+      return result;
+   }
+
+   void optimise_vertex_cache(gsl::span<GLuint> const elements, std::size_t const vertex_count,
+      std::size_t const cache_size)
+   {
+      Expects(ranges::size(elements) % 3 == 0);
+      if (ranges::empty(elements))
+         return;
+
+      auto const triangle_count = ranges::size(elements) / 3;
+      auto const adjacent = adjacency{elements, vertex_count};
+
+      // The number of triangles that each vertex is still needed by.
+      auto live = std::vector<GLuint>(vertex_count);
+      for (auto v = std::size_t{0}; v < vertex_count; ++v)
+         live[v] = adjacent.offsets[v + 1] - adjacent.offsets[v];
+
+      auto cache_time = std::vector<std::size_t>(vertex_count);
+      auto emitted = std::vector<bool>(gsl::narrow_cast<std::size_t>(triangle_count));
+      auto dead_ends = std::vector<GLuint>{};
+      auto candidates = std::vector<GLuint>{};
+      auto output = std::vector<GLuint>{};
+      output.reserve(ranges::size(elements));
+
+      auto time = cache_size + 1;
+      auto cursor = GLuint{0};
+      auto fan = elements[0];
+      while (fan != none) {
+         // Emit every triangle around the fanning vertex.
+         candidates.clear();
+         for (auto const t : adjacent.of(fan)) {
+            if (emitted[t])
+               continue;
+
+            for (auto corner = 0; corner < 3; ++corner) {
+               auto const v = elements[3 * t + corner];
+               output.push_back(v);
+               dead_ends.push_back(v);
+               candidates.push_back(v);
+               --live[v];
+               if (time - cache_time[v] > cache_size)
+                  cache_time[v] = time++;
+            }
+
+            emitted[t] = true;
+         }
+
+         // Fan next from the candidate that will stay in the cache the longest, as long as its
+         // remaining triangles won't push it out.
+         fan = none;
+         auto best = std::ptrdiff_t{-1};
+         for (auto const v : candidates) {
+            if (live[v] == 0)
+               continue;
+
+            auto priority = std::ptrdiff_t{0};
+            if (time - cache_time[v] + 2 * live[v] <= cache_size)
+               priority = gsl::narrow_cast<std::ptrdiff_t>(time - cache_time[v]);
+            if (priority > best) {
+               best = priority;
+               fan = v;
+            }
+         }
+
+         // Otherwise, go back to a recently used vertex, and then to the next one in order.
+         while (fan == none && not ranges::empty(dead_ends)) {
+            auto const v = dead_ends.back();
+            dead_ends.pop_back();
+            if (live[v] > 0)
+               fan = v;
+         }
+
+         for (; fan == none && cursor < vertex_count; ++cursor) {
+            if (live[cursor] > 0)
+               fan = cursor;
+         }
+      }
+
+      ranges::copy(output, ranges::begin(elements));
+   }
+
+   std::vector<GLuint> optimise_vertex_fetch(gsl::span<GLuint> const elements,
+      std::size_t const vertex_count)
+   {
+      auto remap = std::vector<GLuint>(vertex_count, none);
+      auto next = GLuint{0};
+      for (auto& e : elements) {
+         if (remap[e] == none)
+            remap[e] = next++;
+         e = remap[e];
+      }
+
+      for (auto& r : remap) {
+         if (r == none)
+            r = next++;
+      }
+
+      return remap;
+   }
+
+   double average_cache_miss_ratio(gsl::span<GLuint const> const elements,
+      std::size_t const vertex_count, std::size_t const cache_size)
+   {
+      if (ranges::empty(elements))
+         return 0.0;
+
+      // A vertex is in the cache if it was added within the last cache_size misses.
+      auto added = std::vector<std::size_t>(vertex_count, 0);
+      auto misses = std::size_t{0};
+      for (auto const v : elements) {
+         if (added[v] == 0 || misses - added[v] >= cache_size)
+            added[v] = ++misses;
+      }
+
+      return static_cast<double>(misses) / static_cast<double>(ranges::size(elements) / 3);
+   }
+
+   simplification simplify(gsl::span<GLuint const> const elements,
+      gsl::span<std::array<float, 3> const> const positions, std::size_t const target_count,
+      float const max_error)
+   {
+      Expects(ranges::size(elements) % 3 == 0);
+      auto const vertex_count = gsl::narrow_cast<std::size_t>(ranges::size(positions));
+      auto result = simplification{{ranges::begin(elements), ranges::end(elements)}, 0.0f};
+      auto& current = result.elements;
+
+      // Vertices with the same position, such as either side of a UV seam, are one point.
+      auto const point = index_vertices(gsl::as_bytes(positions), sizeof(position));
+      auto const point_count = ranges::empty(point) ? std::size_t{0}
+                                                    : std::size_t{*ranges::max_element(point)} + 1;
+      auto const locked = locked_points(current, point, point_count);
+
+      auto quadrics = std::vector<quadric>(point_count);
+      for (auto i = std::size_t{0}; i < ranges::size(current); i += 3) {
+         auto const q = quadric::of_triangle(positions[current[i]], positions[current[i + 1]],
+            positions[current[i + 2]]);
+         for (auto corner = 0; corner < 3; ++corner)
+            quadrics[point[current[i + corner]]] += q;
+      }
+
+      struct collapse {
+         GLuint from;
+         GLuint to;
+         double cost;
+      };
+
+      auto const max_cost = double{max_error} * double{max_error};
+      auto candidates = std::vector<collapse>{};
+      auto touched = std::vector<bool>{};
+      auto target = std::vector<GLuint>(vertex_count);
+      auto next = std::vector<GLuint>{};
+
+      // Each pass collapses edges that don't share any triangles, cheapest first, and then
+      // rebuilds the triangles.
+      while (ranges::size(current) > target_count) {
+         auto const adjacent = adjacency{current, vertex_count};
+
+         candidates.clear();
+         for (auto i = std::size_t{0}; i < ranges::size(current); ++i) {
+            auto const a = current[i];
+            auto const b = current[i - i % 3 + (i + 1) % 3];
+            for (auto const [from, to] : {std::array{a, b}, std::array{b, a}}) {
+               if (locked[point[from]])
+                  continue;
+
+               auto q = quadrics[point[from]];
+               q += quadrics[point[to]];
+               candidates.push_back(collapse{from, to, q.error(positions[to])});
+            }
+         }
+
+         ranges::sort(candidates, [](collapse const& x, collapse const& y) {
+            return x.cost < y.cost; });
+
+         // A vertex that isn't locked is the only one at its position, so moving it changes nothing
+         // else. The move mustn't flip a triangle, or leave its triangles using two different
+         // vertices at the new position.
+         auto const allowed = [&](collapse const& c) {
+            for (auto const t : adjacent.of(c.from)) {
+               auto corners = std::array<position, 3>{};
+               for (auto corner = 0; corner < 3; ++corner) {
+                  auto const v = current[3 * t + corner];
+                  if (point[v] == point[c.to] && v != c.to)
+                     return false;
+                  corners[corner] = positions[v == c.from ? c.to : v];
+               }
+
+               // The triangles on the edge itself are removed, so they can't flip.
+               if (current[3 * t] == c.to || current[3 * t + 1] == c.to
+                  || current[3 * t + 2] == c.to) {
+                  continue;
+               }
+
+               // Turning a triangle by more than about 75 degrees is treated as flipping it, since
+               // that's usually a sliver that's about to fold over.
+               auto const before = normal_of(positions[current[3 * t]],
+                  positions[current[3 * t + 1]], positions[current[3 * t + 2]]);
+               auto const after = normal_of(corners[0], corners[1], corners[2]);
+               if (dot(before, after) <= 0.25 * std::sqrt(dot(before, before) * dot(after, after)))
+                  return false;
+            }
+
+            return true;
+         };
+
+         touched.assign(point_count, false);
+         std::iota(ranges::begin(target), ranges::end(target), GLuint{0});
+         auto triangles = ranges::size(current) / 3;
+         auto collapsed = false;
+         for (auto const& c : candidates) {
+            if (c.cost > max_cost || 3 * triangles <= target_count)
+               break;
+            if (touched[point[c.from]] || touched[point[c.to]] || not allowed(c))
+               continue;
+
+            target[c.from] = c.to;
+            quadrics[point[c.to]] += quadrics[point[c.from]];
+            result.error = std::max(result.error, gsl::narrow_cast<float>(std::sqrt(c.cost)));
+            collapsed = true;
+
+            // The triangles around from have changed, so none of their corners can be collapsed
+            // again until the next pass.
+            for (auto const t : adjacent.of(c.from)) {
+               for (auto corner = 0; corner < 3; ++corner)
+                  touched[point[current[3 * t + corner]]] = true;
+            }
+
+            // Collapsing an edge that isn't on a border removes the two triangles on either side.
+            triangles -= std::min(triangles, std::size_t{2});
+         }
+
+         if (not collapsed)
+            break;
+
+         next.clear();
+         for (auto i = std::size_t{0}; i < ranges::size(current); i += 3) {
+            auto const a = target[current[i]];
+            auto const b = target[current[i + 1]];
+            auto const c = target[current[i + 2]];
+            if (point[a] != point[b] && point[b] != point[c] && point[c] != point[a])
+               next.insert(ranges::end(next), {a, b, c});
+         }
+
+         current.swap(next);
+      }
+
+      return result;
+   }
+} // namespace doge
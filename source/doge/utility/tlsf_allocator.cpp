@@ -0,0 +1,266 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <doge/utility/tlsf_allocator.hpp>
+#include <experimental/ranges/algorithm>
+#include <experimental/ranges/iterator>
+#include <gsl/gsl>
+
+namespace {
+   namespace ranges = std::experimental::ranges;
+
+   int floor_log2(std::uint64_t const x) noexcept
+   {
+      return 63 - __builtin_clzll(x);
+   }
+
+   int lowest_set(std::uint64_t const x) noexcept
+   {
+      return __builtin_ctzll(x);
+   }
+
+   constexpr std::size_t round_up(std::size_t const n, std::size_t const alignment) noexcept
+   {
+      return (n + alignment - 1) / alignment * alignment;
+   }
+} // namespace <anonymous>
+
+namespace doge {
+   tlsf_allocator::tlsf_allocator(std::size_t const capacity)
+   {
+      ranges::fill(bins_, no_node);
+      grow(capacity);
+   }
+
+   std::optional<tlsf_allocator::allocation> tlsf_allocator::allocate(std::size_t const size,
+      std::size_t const alignment)
+   {
+      Expects(size > 0);
+      Expects(alignment > 0);
+
+      // Asking for alignment - 1 extra units means that any range that's found can be aligned.
+      auto const n = find_free(size + alignment - 1);
+      if (n == no_node)
+         return std::nullopt;
+
+      remove_free(n);
+
+      auto const aligned = round_up(nodes_[n].offset, alignment);
+      if (auto const padding = aligned - nodes_[n].offset; padding > 0) {
+         // The padding goes back on the free list. The range before it is already in use, since
+         // free neighbours are always merged.
+         auto const front = make_node(nodes_[n].offset, padding);
+         nodes_[front].previous = nodes_[n].previous;
+         nodes_[front].next = n;
+         if (nodes_[n].previous != no_node)
+            nodes_[nodes_[n].previous].next = front;
+         nodes_[n].previous = front;
+         nodes_[n].offset = aligned;
+         nodes_[n].size -= padding;
+         insert_free(front);
+      }
+
+      if (nodes_[n].size > size) {
+         auto const back = make_node(aligned + size, nodes_[n].size - size);
+         nodes_[back].previous = n;
+         nodes_[back].next = nodes_[n].next;
+         if (nodes_[n].next != no_node)
+            nodes_[nodes_[n].next].previous = back;
+         else
+            last_ = back;
+         nodes_[n].next = back;
+         nodes_[n].size = size;
+         insert_free(back);
+      }
+
+      nodes_[n].used = true;
+      available_ -= size;
+      return allocation{aligned, size, n};
+   }
+
+   void tlsf_allocator::deallocate(allocation const& a) noexcept
+   {
+      Expects(a.node < ranges::size(nodes_));
+      Expects(nodes_[a.node].used);
+
+      auto n = a.node;
+      nodes_[n].used = false;
+      available_ += nodes_[n].size;
+
+      if (auto const next = nodes_[n].next; next != no_node && not nodes_[next].used) {
+         remove_free(next);
+         absorb_next(n);
+      }
+
+      if (auto const previous = nodes_[n].previous; previous != no_node
+         && not nodes_[previous].used) {
+         remove_free(previous);
+         absorb_next(previous);
+         n = previous;
+      }
+
+      insert_free(n);
+   }
+
+   void tlsf_allocator::grow(std::size_t const capacity)
+   {
+      Expects(capacity >= capacity_);
+      auto const extra = capacity - capacity_;
+      if (extra == 0)
+         return;
+
+      if (last_ != no_node && not nodes_[last_].used) {
+         remove_free(last_);
+         nodes_[last_].size += extra;
+         insert_free(last_);
+      }
+      else {
+         auto const n = make_node(capacity_, extra);
+         nodes_[n].previous = last_;
+         if (last_ != no_node)
+            nodes_[last_].next = n;
+         last_ = n;
+         insert_free(n);
+      }
+
+      capacity_ = capacity;
+      available_ += extra;
+   }
+
+   // Sizes below 2^second_level_bits have a bin each. Every power of two above that is split into
+   // second_level_count bins.
+   std::size_t tlsf_allocator::bin_of(std::size_t const size) noexcept
+   {
+      auto const log2 = floor_log2(size);
+      if (log2 < second_level_bits)
+         return size;
+
+      auto const first = gsl::narrow_cast<std::size_t>(log2 - second_level_bits + 1);
+      auto const second = (size >> (log2 - second_level_bits)) & (second_level_count - 1);
+      return (first << second_level_bits) | second;
+   }
+
+   // The first bin whose ranges are all at least size units, so the search never has to look
+   // inside a bin.
+   std::size_t tlsf_allocator::search_bin_of(std::size_t size) noexcept
+   {
+      auto const log2 = floor_log2(size);
+      if (log2 >= second_level_bits)
+         size += (std::size_t{1} << (log2 - second_level_bits)) - 1;
+      return bin_of(size);
+   }
+
+   std::uint32_t tlsf_allocator::make_node(std::size_t const offset, std::size_t const size)
+   {
+      auto n = released_;
+      if (n == no_node) {
+         n = gsl::narrow_cast<std::uint32_t>(ranges::size(nodes_));
+         nodes_.emplace_back();
+      }
+      else {
+         released_ = nodes_[n].next_free;
+         nodes_[n] = node{};
+      }
+
+      nodes_[n].offset = offset;
+      nodes_[n].size = size;
+      return n;
+   }
+
+   void tlsf_allocator::release_node(std::uint32_t const n) noexcept
+   {
+      nodes_[n].next_free = released_;
+      released_ = n;
+   }
+
+   void tlsf_allocator::insert_free(std::uint32_t const n) noexcept
+   {
+      auto const bin = bin_of(nodes_[n].size);
+      auto& head = bins_[bin];
+      nodes_[n].previous_free = no_node;
+      nodes_[n].next_free = head;
+      if (head != no_node)
+         nodes_[head].previous_free = n;
+      head = n;
+
+      auto const first = bin >> second_level_bits;
+      first_level_bitmap_ |= std::uint64_t{1} << first;
+      second_level_bitmaps_[first] |= gsl::narrow_cast<std::uint16_t>(
+         1u << (bin & (second_level_count - 1)));
+   }
+
+   void tlsf_allocator::remove_free(std::uint32_t const n) noexcept
+   {
+      auto const bin = bin_of(nodes_[n].size);
+      auto const& current = nodes_[n];
+      if (current.previous_free != no_node)
+         nodes_[current.previous_free].next_free = current.next_free;
+      else
+         bins_[bin] = current.next_free;
+
+      if (current.next_free != no_node)
+         nodes_[current.next_free].previous_free = current.previous_free;
+
+      if (bins_[bin] != no_node)
+         return;
+
+      auto const first = bin >> second_level_bits;
+      second_level_bitmaps_[first] &= gsl::narrow_cast<std::uint16_t>(
+         ~(1u << (bin & (second_level_count - 1))));
+      if (second_level_bitmaps_[first] == 0)
+         first_level_bitmap_ &= ~(std::uint64_t{1} << first);
+   }
+
+   std::uint32_t tlsf_allocator::find_free(std::size_t const size) const noexcept
+   {
+      auto const bin = search_bin_of(size);
+      if (auto first = bin >> second_level_bits; first < first_level_count) {
+         auto second_level = second_level_bitmaps_[first]
+                           & (~0u << (bin & (second_level_count - 1)));
+         if (second_level == 0) {
+            auto const larger = first_level_bitmap_ & (~std::uint64_t{0} << (first + 1));
+            first = larger != 0 ? gsl::narrow_cast<std::size_t>(lowest_set(larger))
+                                : first_level_count;
+            second_level = larger != 0 ? second_level_bitmaps_[first] : 0u;
+         }
+
+         if (second_level != 0) {
+            return bins_[(first << second_level_bits)
+               | gsl::narrow_cast<std::size_t>(lowest_set(second_level))];
+         }
+      }
+
+      // Nothing bigger is free, but the bin that size itself falls in can still hold a range
+      // that's big enough, such as the whole of an empty heap.
+      for (auto n = bins_[bin_of(size)]; n != no_node; n = nodes_[n].next_free) {
+         if (nodes_[n].size >= size)
+            return n;
+      }
+
+      return no_node;
+   }
+
+   void tlsf_allocator::absorb_next(std::uint32_t const n) noexcept
+   {
+      auto const next = nodes_[n].next;
+      nodes_[n].size += nodes_[next].size;
+      nodes_[n].next = nodes_[next].next;
+      if (nodes_[n].next != no_node)
+         nodes_[nodes_[n].next].previous = n;
+      else
+         last_ = n;
+      release_node(next);
+   }
+} // namespace doge
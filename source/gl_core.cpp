@@ -90,7 +90,427 @@ namespace gl
 {
 	namespace exts
 	{
+		LoadTest var_ARB_buffer_storage;
+		
+		LoadTest var_ARB_direct_state_access;
+		
 	} //namespace exts
+	// Extension: ARB_buffer_storage
+	typedef void (CODEGEN_FUNCPTR *PFNBUFFERSTORAGE)(GLenum, GLsizeiptr, const void *, GLbitfield);
+	PFNBUFFERSTORAGE BufferStorage = 0;
+	
+	static int Load_ARB_buffer_storage()
+	{
+		int numFailed = 0;
+		BufferStorage = reinterpret_cast<PFNBUFFERSTORAGE>(IntGetProcAddress("glBufferStorage"));
+		if(!BufferStorage) ++numFailed;
+		return numFailed;
+	}
+	
+	// Extension: ARB_direct_state_access
+	typedef void (CODEGEN_FUNCPTR *PFNBINDTEXTUREUNIT)(GLuint, GLuint);
+	PFNBINDTEXTUREUNIT BindTextureUnit = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNBLITNAMEDFRAMEBUFFER)(GLuint, GLuint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum);
+	PFNBLITNAMEDFRAMEBUFFER BlitNamedFramebuffer = 0;
+	typedef GLenum (CODEGEN_FUNCPTR *PFNCHECKNAMEDFRAMEBUFFERSTATUS)(GLuint, GLenum);
+	PFNCHECKNAMEDFRAMEBUFFERSTATUS CheckNamedFramebufferStatus = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCLEARNAMEDBUFFERDATA)(GLuint, GLenum, GLenum, GLenum, const void *);
+	PFNCLEARNAMEDBUFFERDATA ClearNamedBufferData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCLEARNAMEDBUFFERSUBDATA)(GLuint, GLenum, GLintptr, GLsizeiptr, GLenum, GLenum, const void *);
+	PFNCLEARNAMEDBUFFERSUBDATA ClearNamedBufferSubData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCLEARNAMEDFRAMEBUFFERFI)(GLuint, GLenum, GLint, GLfloat, GLint);
+	PFNCLEARNAMEDFRAMEBUFFERFI ClearNamedFramebufferfi = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCLEARNAMEDFRAMEBUFFERFV)(GLuint, GLenum, GLint, const GLfloat *);
+	PFNCLEARNAMEDFRAMEBUFFERFV ClearNamedFramebufferfv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCLEARNAMEDFRAMEBUFFERIV)(GLuint, GLenum, GLint, const GLint *);
+	PFNCLEARNAMEDFRAMEBUFFERIV ClearNamedFramebufferiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCLEARNAMEDFRAMEBUFFERUIV)(GLuint, GLenum, GLint, const GLuint *);
+	PFNCLEARNAMEDFRAMEBUFFERUIV ClearNamedFramebufferuiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOMPRESSEDTEXTURESUBIMAGE1D)(GLuint, GLint, GLint, GLsizei, GLenum, GLsizei, const void *);
+	PFNCOMPRESSEDTEXTURESUBIMAGE1D CompressedTextureSubImage1D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOMPRESSEDTEXTURESUBIMAGE2D)(GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+	PFNCOMPRESSEDTEXTURESUBIMAGE2D CompressedTextureSubImage2D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOMPRESSEDTEXTURESUBIMAGE3D)(GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+	PFNCOMPRESSEDTEXTURESUBIMAGE3D CompressedTextureSubImage3D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOPYNAMEDBUFFERSUBDATA)(GLuint, GLuint, GLintptr, GLintptr, GLsizeiptr);
+	PFNCOPYNAMEDBUFFERSUBDATA CopyNamedBufferSubData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOPYTEXTURESUBIMAGE1D)(GLuint, GLint, GLint, GLint, GLint, GLsizei);
+	PFNCOPYTEXTURESUBIMAGE1D CopyTextureSubImage1D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOPYTEXTURESUBIMAGE2D)(GLuint, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei);
+	PFNCOPYTEXTURESUBIMAGE2D CopyTextureSubImage2D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCOPYTEXTURESUBIMAGE3D)(GLuint, GLint, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei);
+	PFNCOPYTEXTURESUBIMAGE3D CopyTextureSubImage3D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATEBUFFERS)(GLsizei, GLuint *);
+	PFNCREATEBUFFERS CreateBuffers = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATEFRAMEBUFFERS)(GLsizei, GLuint *);
+	PFNCREATEFRAMEBUFFERS CreateFramebuffers = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATEPROGRAMPIPELINES)(GLsizei, GLuint *);
+	PFNCREATEPROGRAMPIPELINES CreateProgramPipelines = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATEQUERIES)(GLenum, GLsizei, GLuint *);
+	PFNCREATEQUERIES CreateQueries = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATERENDERBUFFERS)(GLsizei, GLuint *);
+	PFNCREATERENDERBUFFERS CreateRenderbuffers = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATESAMPLERS)(GLsizei, GLuint *);
+	PFNCREATESAMPLERS CreateSamplers = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATETEXTURES)(GLenum, GLsizei, GLuint *);
+	PFNCREATETEXTURES CreateTextures = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATETRANSFORMFEEDBACKS)(GLsizei, GLuint *);
+	PFNCREATETRANSFORMFEEDBACKS CreateTransformFeedbacks = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNCREATEVERTEXARRAYS)(GLsizei, GLuint *);
+	PFNCREATEVERTEXARRAYS CreateVertexArrays = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNDISABLEVERTEXARRAYATTRIB)(GLuint, GLuint);
+	PFNDISABLEVERTEXARRAYATTRIB DisableVertexArrayAttrib = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNENABLEVERTEXARRAYATTRIB)(GLuint, GLuint);
+	PFNENABLEVERTEXARRAYATTRIB EnableVertexArrayAttrib = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNFLUSHMAPPEDNAMEDBUFFERRANGE)(GLuint, GLintptr, GLsizeiptr);
+	PFNFLUSHMAPPEDNAMEDBUFFERRANGE FlushMappedNamedBufferRange = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGENERATETEXTUREMIPMAP)(GLuint);
+	PFNGENERATETEXTUREMIPMAP GenerateTextureMipmap = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETCOMPRESSEDTEXTUREIMAGE)(GLuint, GLint, GLsizei, void *);
+	PFNGETCOMPRESSEDTEXTUREIMAGE GetCompressedTextureImage = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETCOMPRESSEDTEXTURESUBIMAGE)(GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLsizei, void *);
+	PFNGETCOMPRESSEDTEXTURESUBIMAGE GetCompressedTextureSubImage = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDBUFFERPARAMETERI64V)(GLuint, GLenum, GLint64 *);
+	PFNGETNAMEDBUFFERPARAMETERI64V GetNamedBufferParameteri64v = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDBUFFERPARAMETERIV)(GLuint, GLenum, GLint *);
+	PFNGETNAMEDBUFFERPARAMETERIV GetNamedBufferParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDBUFFERPOINTERV)(GLuint, GLenum, void **);
+	PFNGETNAMEDBUFFERPOINTERV GetNamedBufferPointerv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDBUFFERSUBDATA)(GLuint, GLintptr, GLsizeiptr, void *);
+	PFNGETNAMEDBUFFERSUBDATA GetNamedBufferSubData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDFRAMEBUFFERATTACHMENTPARAMETERIV)(GLuint, GLenum, GLenum, GLint *);
+	PFNGETNAMEDFRAMEBUFFERATTACHMENTPARAMETERIV GetNamedFramebufferAttachmentParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDFRAMEBUFFERPARAMETERIV)(GLuint, GLenum, GLint *);
+	PFNGETNAMEDFRAMEBUFFERPARAMETERIV GetNamedFramebufferParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETNAMEDRENDERBUFFERPARAMETERIV)(GLuint, GLenum, GLint *);
+	PFNGETNAMEDRENDERBUFFERPARAMETERIV GetNamedRenderbufferParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETQUERYBUFFEROBJECTI64V)(GLuint, GLuint, GLenum, GLintptr);
+	PFNGETQUERYBUFFEROBJECTI64V GetQueryBufferObjecti64v = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETQUERYBUFFEROBJECTIV)(GLuint, GLuint, GLenum, GLintptr);
+	PFNGETQUERYBUFFEROBJECTIV GetQueryBufferObjectiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETQUERYBUFFEROBJECTUI64V)(GLuint, GLuint, GLenum, GLintptr);
+	PFNGETQUERYBUFFEROBJECTUI64V GetQueryBufferObjectui64v = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETQUERYBUFFEROBJECTUIV)(GLuint, GLuint, GLenum, GLintptr);
+	PFNGETQUERYBUFFEROBJECTUIV GetQueryBufferObjectuiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTUREIMAGE)(GLuint, GLint, GLenum, GLenum, GLsizei, void *);
+	PFNGETTEXTUREIMAGE GetTextureImage = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTURELEVELPARAMETERFV)(GLuint, GLint, GLenum, GLfloat *);
+	PFNGETTEXTURELEVELPARAMETERFV GetTextureLevelParameterfv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTURELEVELPARAMETERIV)(GLuint, GLint, GLenum, GLint *);
+	PFNGETTEXTURELEVELPARAMETERIV GetTextureLevelParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTUREPARAMETERIIV)(GLuint, GLenum, GLint *);
+	PFNGETTEXTUREPARAMETERIIV GetTextureParameterIiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTUREPARAMETERIUIV)(GLuint, GLenum, GLuint *);
+	PFNGETTEXTUREPARAMETERIUIV GetTextureParameterIuiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTUREPARAMETERFV)(GLuint, GLenum, GLfloat *);
+	PFNGETTEXTUREPARAMETERFV GetTextureParameterfv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTUREPARAMETERIV)(GLuint, GLenum, GLint *);
+	PFNGETTEXTUREPARAMETERIV GetTextureParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTEXTURESUBIMAGE)(GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, GLsizei, void *);
+	PFNGETTEXTURESUBIMAGE GetTextureSubImage = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTRANSFORMFEEDBACKI64_V)(GLuint, GLenum, GLuint, GLint64 *);
+	PFNGETTRANSFORMFEEDBACKI64_V GetTransformFeedbacki64_v = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTRANSFORMFEEDBACKI_V)(GLuint, GLenum, GLuint, GLint *);
+	PFNGETTRANSFORMFEEDBACKI_V GetTransformFeedbacki_v = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETTRANSFORMFEEDBACKIV)(GLuint, GLenum, GLint *);
+	PFNGETTRANSFORMFEEDBACKIV GetTransformFeedbackiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETVERTEXARRAYINDEXED64IV)(GLuint, GLuint, GLenum, GLint64 *);
+	PFNGETVERTEXARRAYINDEXED64IV GetVertexArrayIndexed64iv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETVERTEXARRAYINDEXEDIV)(GLuint, GLuint, GLenum, GLint *);
+	PFNGETVERTEXARRAYINDEXEDIV GetVertexArrayIndexediv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNGETVERTEXARRAYIV)(GLuint, GLenum, GLint *);
+	PFNGETVERTEXARRAYIV GetVertexArrayiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNINVALIDATENAMEDFRAMEBUFFERDATA)(GLuint, GLsizei, const GLenum *);
+	PFNINVALIDATENAMEDFRAMEBUFFERDATA InvalidateNamedFramebufferData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNINVALIDATENAMEDFRAMEBUFFERSUBDATA)(GLuint, GLsizei, const GLenum *, GLint, GLint, GLsizei, GLsizei);
+	PFNINVALIDATENAMEDFRAMEBUFFERSUBDATA InvalidateNamedFramebufferSubData = 0;
+	typedef void * (CODEGEN_FUNCPTR *PFNMAPNAMEDBUFFER)(GLuint, GLenum);
+	PFNMAPNAMEDBUFFER MapNamedBuffer = 0;
+	typedef void * (CODEGEN_FUNCPTR *PFNMAPNAMEDBUFFERRANGE)(GLuint, GLintptr, GLsizeiptr, GLbitfield);
+	PFNMAPNAMEDBUFFERRANGE MapNamedBufferRange = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDBUFFERDATA)(GLuint, GLsizeiptr, const void *, GLenum);
+	PFNNAMEDBUFFERDATA NamedBufferData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDBUFFERSTORAGE)(GLuint, GLsizeiptr, const void *, GLbitfield);
+	PFNNAMEDBUFFERSTORAGE NamedBufferStorage = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDBUFFERSUBDATA)(GLuint, GLintptr, GLsizeiptr, const void *);
+	PFNNAMEDBUFFERSUBDATA NamedBufferSubData = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERDRAWBUFFER)(GLuint, GLenum);
+	PFNNAMEDFRAMEBUFFERDRAWBUFFER NamedFramebufferDrawBuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERDRAWBUFFERS)(GLuint, GLsizei, const GLenum *);
+	PFNNAMEDFRAMEBUFFERDRAWBUFFERS NamedFramebufferDrawBuffers = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERPARAMETERI)(GLuint, GLenum, GLint);
+	PFNNAMEDFRAMEBUFFERPARAMETERI NamedFramebufferParameteri = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERREADBUFFER)(GLuint, GLenum);
+	PFNNAMEDFRAMEBUFFERREADBUFFER NamedFramebufferReadBuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERRENDERBUFFER)(GLuint, GLenum, GLenum, GLuint);
+	PFNNAMEDFRAMEBUFFERRENDERBUFFER NamedFramebufferRenderbuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERTEXTURE)(GLuint, GLenum, GLuint, GLint);
+	PFNNAMEDFRAMEBUFFERTEXTURE NamedFramebufferTexture = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDFRAMEBUFFERTEXTURELAYER)(GLuint, GLenum, GLuint, GLint, GLint);
+	PFNNAMEDFRAMEBUFFERTEXTURELAYER NamedFramebufferTextureLayer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDRENDERBUFFERSTORAGE)(GLuint, GLenum, GLsizei, GLsizei);
+	PFNNAMEDRENDERBUFFERSTORAGE NamedRenderbufferStorage = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNNAMEDRENDERBUFFERSTORAGEMULTISAMPLE)(GLuint, GLsizei, GLenum, GLsizei, GLsizei);
+	PFNNAMEDRENDERBUFFERSTORAGEMULTISAMPLE NamedRenderbufferStorageMultisample = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREBUFFER)(GLuint, GLenum, GLuint);
+	PFNTEXTUREBUFFER TextureBuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREBUFFERRANGE)(GLuint, GLenum, GLuint, GLintptr, GLsizeiptr);
+	PFNTEXTUREBUFFERRANGE TextureBufferRange = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREPARAMETERIIV)(GLuint, GLenum, const GLint *);
+	PFNTEXTUREPARAMETERIIV TextureParameterIiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREPARAMETERIUIV)(GLuint, GLenum, const GLuint *);
+	PFNTEXTUREPARAMETERIUIV TextureParameterIuiv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREPARAMETERF)(GLuint, GLenum, GLfloat);
+	PFNTEXTUREPARAMETERF TextureParameterf = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREPARAMETERFV)(GLuint, GLenum, const GLfloat *);
+	PFNTEXTUREPARAMETERFV TextureParameterfv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREPARAMETERI)(GLuint, GLenum, GLint);
+	PFNTEXTUREPARAMETERI TextureParameteri = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTUREPARAMETERIV)(GLuint, GLenum, const GLint *);
+	PFNTEXTUREPARAMETERIV TextureParameteriv = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESTORAGE1D)(GLuint, GLsizei, GLenum, GLsizei);
+	PFNTEXTURESTORAGE1D TextureStorage1D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESTORAGE2D)(GLuint, GLsizei, GLenum, GLsizei, GLsizei);
+	PFNTEXTURESTORAGE2D TextureStorage2D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESTORAGE2DMULTISAMPLE)(GLuint, GLsizei, GLenum, GLsizei, GLsizei, GLboolean);
+	PFNTEXTURESTORAGE2DMULTISAMPLE TextureStorage2DMultisample = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESTORAGE3D)(GLuint, GLsizei, GLenum, GLsizei, GLsizei, GLsizei);
+	PFNTEXTURESTORAGE3D TextureStorage3D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESTORAGE3DMULTISAMPLE)(GLuint, GLsizei, GLenum, GLsizei, GLsizei, GLsizei, GLboolean);
+	PFNTEXTURESTORAGE3DMULTISAMPLE TextureStorage3DMultisample = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESUBIMAGE1D)(GLuint, GLint, GLint, GLsizei, GLenum, GLenum, const void *);
+	PFNTEXTURESUBIMAGE1D TextureSubImage1D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESUBIMAGE2D)(GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void *);
+	PFNTEXTURESUBIMAGE2D TextureSubImage2D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTEXTURESUBIMAGE3D)(GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void *);
+	PFNTEXTURESUBIMAGE3D TextureSubImage3D = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTRANSFORMFEEDBACKBUFFERBASE)(GLuint, GLuint, GLuint);
+	PFNTRANSFORMFEEDBACKBUFFERBASE TransformFeedbackBufferBase = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNTRANSFORMFEEDBACKBUFFERRANGE)(GLuint, GLuint, GLuint, GLintptr, GLsizeiptr);
+	PFNTRANSFORMFEEDBACKBUFFERRANGE TransformFeedbackBufferRange = 0;
+	typedef GLboolean (CODEGEN_FUNCPTR *PFNUNMAPNAMEDBUFFER)(GLuint);
+	PFNUNMAPNAMEDBUFFER UnmapNamedBuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYATTRIBBINDING)(GLuint, GLuint, GLuint);
+	PFNVERTEXARRAYATTRIBBINDING VertexArrayAttribBinding = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYATTRIBFORMAT)(GLuint, GLuint, GLint, GLenum, GLboolean, GLuint);
+	PFNVERTEXARRAYATTRIBFORMAT VertexArrayAttribFormat = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYATTRIBIFORMAT)(GLuint, GLuint, GLint, GLenum, GLuint);
+	PFNVERTEXARRAYATTRIBIFORMAT VertexArrayAttribIFormat = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYATTRIBLFORMAT)(GLuint, GLuint, GLint, GLenum, GLuint);
+	PFNVERTEXARRAYATTRIBLFORMAT VertexArrayAttribLFormat = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYBINDINGDIVISOR)(GLuint, GLuint, GLuint);
+	PFNVERTEXARRAYBINDINGDIVISOR VertexArrayBindingDivisor = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYELEMENTBUFFER)(GLuint, GLuint);
+	PFNVERTEXARRAYELEMENTBUFFER VertexArrayElementBuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYVERTEXBUFFER)(GLuint, GLuint, GLuint, GLintptr, GLsizei);
+	PFNVERTEXARRAYVERTEXBUFFER VertexArrayVertexBuffer = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNVERTEXARRAYVERTEXBUFFERS)(GLuint, GLuint, GLsizei, const GLuint *, const GLintptr *, const GLsizei *);
+	PFNVERTEXARRAYVERTEXBUFFERS VertexArrayVertexBuffers = 0;
+	
+	static int Load_ARB_direct_state_access()
+	{
+		int numFailed = 0;
+		BindTextureUnit = reinterpret_cast<PFNBINDTEXTUREUNIT>(IntGetProcAddress("glBindTextureUnit"));
+		if(!BindTextureUnit) ++numFailed;
+		BlitNamedFramebuffer = reinterpret_cast<PFNBLITNAMEDFRAMEBUFFER>(IntGetProcAddress("glBlitNamedFramebuffer"));
+		if(!BlitNamedFramebuffer) ++numFailed;
+		CheckNamedFramebufferStatus = reinterpret_cast<PFNCHECKNAMEDFRAMEBUFFERSTATUS>(IntGetProcAddress("glCheckNamedFramebufferStatus"));
+		if(!CheckNamedFramebufferStatus) ++numFailed;
+		ClearNamedBufferData = reinterpret_cast<PFNCLEARNAMEDBUFFERDATA>(IntGetProcAddress("glClearNamedBufferData"));
+		if(!ClearNamedBufferData) ++numFailed;
+		ClearNamedBufferSubData = reinterpret_cast<PFNCLEARNAMEDBUFFERSUBDATA>(IntGetProcAddress("glClearNamedBufferSubData"));
+		if(!ClearNamedBufferSubData) ++numFailed;
+		ClearNamedFramebufferfi = reinterpret_cast<PFNCLEARNAMEDFRAMEBUFFERFI>(IntGetProcAddress("glClearNamedFramebufferfi"));
+		if(!ClearNamedFramebufferfi) ++numFailed;
+		ClearNamedFramebufferfv = reinterpret_cast<PFNCLEARNAMEDFRAMEBUFFERFV>(IntGetProcAddress("glClearNamedFramebufferfv"));
+		if(!ClearNamedFramebufferfv) ++numFailed;
+		ClearNamedFramebufferiv = reinterpret_cast<PFNCLEARNAMEDFRAMEBUFFERIV>(IntGetProcAddress("glClearNamedFramebufferiv"));
+		if(!ClearNamedFramebufferiv) ++numFailed;
+		ClearNamedFramebufferuiv = reinterpret_cast<PFNCLEARNAMEDFRAMEBUFFERUIV>(IntGetProcAddress("glClearNamedFramebufferuiv"));
+		if(!ClearNamedFramebufferuiv) ++numFailed;
+		CompressedTextureSubImage1D = reinterpret_cast<PFNCOMPRESSEDTEXTURESUBIMAGE1D>(IntGetProcAddress("glCompressedTextureSubImage1D"));
+		if(!CompressedTextureSubImage1D) ++numFailed;
+		CompressedTextureSubImage2D = reinterpret_cast<PFNCOMPRESSEDTEXTURESUBIMAGE2D>(IntGetProcAddress("glCompressedTextureSubImage2D"));
+		if(!CompressedTextureSubImage2D) ++numFailed;
+		CompressedTextureSubImage3D = reinterpret_cast<PFNCOMPRESSEDTEXTURESUBIMAGE3D>(IntGetProcAddress("glCompressedTextureSubImage3D"));
+		if(!CompressedTextureSubImage3D) ++numFailed;
+		CopyNamedBufferSubData = reinterpret_cast<PFNCOPYNAMEDBUFFERSUBDATA>(IntGetProcAddress("glCopyNamedBufferSubData"));
+		if(!CopyNamedBufferSubData) ++numFailed;
+		CopyTextureSubImage1D = reinterpret_cast<PFNCOPYTEXTURESUBIMAGE1D>(IntGetProcAddress("glCopyTextureSubImage1D"));
+		if(!CopyTextureSubImage1D) ++numFailed;
+		CopyTextureSubImage2D = reinterpret_cast<PFNCOPYTEXTURESUBIMAGE2D>(IntGetProcAddress("glCopyTextureSubImage2D"));
+		if(!CopyTextureSubImage2D) ++numFailed;
+		CopyTextureSubImage3D = reinterpret_cast<PFNCOPYTEXTURESUBIMAGE3D>(IntGetProcAddress("glCopyTextureSubImage3D"));
+		if(!CopyTextureSubImage3D) ++numFailed;
+		CreateBuffers = reinterpret_cast<PFNCREATEBUFFERS>(IntGetProcAddress("glCreateBuffers"));
+		if(!CreateBuffers) ++numFailed;
+		CreateFramebuffers = reinterpret_cast<PFNCREATEFRAMEBUFFERS>(IntGetProcAddress("glCreateFramebuffers"));
+		if(!CreateFramebuffers) ++numFailed;
+		CreateProgramPipelines = reinterpret_cast<PFNCREATEPROGRAMPIPELINES>(IntGetProcAddress("glCreateProgramPipelines"));
+		if(!CreateProgramPipelines) ++numFailed;
+		CreateQueries = reinterpret_cast<PFNCREATEQUERIES>(IntGetProcAddress("glCreateQueries"));
+		if(!CreateQueries) ++numFailed;
+		CreateRenderbuffers = reinterpret_cast<PFNCREATERENDERBUFFERS>(IntGetProcAddress("glCreateRenderbuffers"));
+		if(!CreateRenderbuffers) ++numFailed;
+		CreateSamplers = reinterpret_cast<PFNCREATESAMPLERS>(IntGetProcAddress("glCreateSamplers"));
+		if(!CreateSamplers) ++numFailed;
+		CreateTextures = reinterpret_cast<PFNCREATETEXTURES>(IntGetProcAddress("glCreateTextures"));
+		if(!CreateTextures) ++numFailed;
+		CreateTransformFeedbacks = reinterpret_cast<PFNCREATETRANSFORMFEEDBACKS>(IntGetProcAddress("glCreateTransformFeedbacks"));
+		if(!CreateTransformFeedbacks) ++numFailed;
+		CreateVertexArrays = reinterpret_cast<PFNCREATEVERTEXARRAYS>(IntGetProcAddress("glCreateVertexArrays"));
+		if(!CreateVertexArrays) ++numFailed;
+		DisableVertexArrayAttrib = reinterpret_cast<PFNDISABLEVERTEXARRAYATTRIB>(IntGetProcAddress("glDisableVertexArrayAttrib"));
+		if(!DisableVertexArrayAttrib) ++numFailed;
+		EnableVertexArrayAttrib = reinterpret_cast<PFNENABLEVERTEXARRAYATTRIB>(IntGetProcAddress("glEnableVertexArrayAttrib"));
+		if(!EnableVertexArrayAttrib) ++numFailed;
+		FlushMappedNamedBufferRange = reinterpret_cast<PFNFLUSHMAPPEDNAMEDBUFFERRANGE>(IntGetProcAddress("glFlushMappedNamedBufferRange"));
+		if(!FlushMappedNamedBufferRange) ++numFailed;
+		GenerateTextureMipmap = reinterpret_cast<PFNGENERATETEXTUREMIPMAP>(IntGetProcAddress("glGenerateTextureMipmap"));
+		if(!GenerateTextureMipmap) ++numFailed;
+		GetCompressedTextureImage = reinterpret_cast<PFNGETCOMPRESSEDTEXTUREIMAGE>(IntGetProcAddress("glGetCompressedTextureImage"));
+		if(!GetCompressedTextureImage) ++numFailed;
+		GetCompressedTextureSubImage = reinterpret_cast<PFNGETCOMPRESSEDTEXTURESUBIMAGE>(IntGetProcAddress("glGetCompressedTextureSubImage"));
+		if(!GetCompressedTextureSubImage) ++numFailed;
+		GetNamedBufferParameteri64v = reinterpret_cast<PFNGETNAMEDBUFFERPARAMETERI64V>(IntGetProcAddress("glGetNamedBufferParameteri64v"));
+		if(!GetNamedBufferParameteri64v) ++numFailed;
+		GetNamedBufferParameteriv = reinterpret_cast<PFNGETNAMEDBUFFERPARAMETERIV>(IntGetProcAddress("glGetNamedBufferParameteriv"));
+		if(!GetNamedBufferParameteriv) ++numFailed;
+		GetNamedBufferPointerv = reinterpret_cast<PFNGETNAMEDBUFFERPOINTERV>(IntGetProcAddress("glGetNamedBufferPointerv"));
+		if(!GetNamedBufferPointerv) ++numFailed;
+		GetNamedBufferSubData = reinterpret_cast<PFNGETNAMEDBUFFERSUBDATA>(IntGetProcAddress("glGetNamedBufferSubData"));
+		if(!GetNamedBufferSubData) ++numFailed;
+		GetNamedFramebufferAttachmentParameteriv = reinterpret_cast<PFNGETNAMEDFRAMEBUFFERATTACHMENTPARAMETERIV>(IntGetProcAddress("glGetNamedFramebufferAttachmentParameteriv"));
+		if(!GetNamedFramebufferAttachmentParameteriv) ++numFailed;
+		GetNamedFramebufferParameteriv = reinterpret_cast<PFNGETNAMEDFRAMEBUFFERPARAMETERIV>(IntGetProcAddress("glGetNamedFramebufferParameteriv"));
+		if(!GetNamedFramebufferParameteriv) ++numFailed;
+		GetNamedRenderbufferParameteriv = reinterpret_cast<PFNGETNAMEDRENDERBUFFERPARAMETERIV>(IntGetProcAddress("glGetNamedRenderbufferParameteriv"));
+		if(!GetNamedRenderbufferParameteriv) ++numFailed;
+		GetQueryBufferObjecti64v = reinterpret_cast<PFNGETQUERYBUFFEROBJECTI64V>(IntGetProcAddress("glGetQueryBufferObjecti64v"));
+		if(!GetQueryBufferObjecti64v) ++numFailed;
+		GetQueryBufferObjectiv = reinterpret_cast<PFNGETQUERYBUFFEROBJECTIV>(IntGetProcAddress("glGetQueryBufferObjectiv"));
+		if(!GetQueryBufferObjectiv) ++numFailed;
+		GetQueryBufferObjectui64v = reinterpret_cast<PFNGETQUERYBUFFEROBJECTUI64V>(IntGetProcAddress("glGetQueryBufferObjectui64v"));
+		if(!GetQueryBufferObjectui64v) ++numFailed;
+		GetQueryBufferObjectuiv = reinterpret_cast<PFNGETQUERYBUFFEROBJECTUIV>(IntGetProcAddress("glGetQueryBufferObjectuiv"));
+		if(!GetQueryBufferObjectuiv) ++numFailed;
+		GetTextureImage = reinterpret_cast<PFNGETTEXTUREIMAGE>(IntGetProcAddress("glGetTextureImage"));
+		if(!GetTextureImage) ++numFailed;
+		GetTextureLevelParameterfv = reinterpret_cast<PFNGETTEXTURELEVELPARAMETERFV>(IntGetProcAddress("glGetTextureLevelParameterfv"));
+		if(!GetTextureLevelParameterfv) ++numFailed;
+		GetTextureLevelParameteriv = reinterpret_cast<PFNGETTEXTURELEVELPARAMETERIV>(IntGetProcAddress("glGetTextureLevelParameteriv"));
+		if(!GetTextureLevelParameteriv) ++numFailed;
+		GetTextureParameterIiv = reinterpret_cast<PFNGETTEXTUREPARAMETERIIV>(IntGetProcAddress("glGetTextureParameterIiv"));
+		if(!GetTextureParameterIiv) ++numFailed;
+		GetTextureParameterIuiv = reinterpret_cast<PFNGETTEXTUREPARAMETERIUIV>(IntGetProcAddress("glGetTextureParameterIuiv"));
+		if(!GetTextureParameterIuiv) ++numFailed;
+		GetTextureParameterfv = reinterpret_cast<PFNGETTEXTUREPARAMETERFV>(IntGetProcAddress("glGetTextureParameterfv"));
+		if(!GetTextureParameterfv) ++numFailed;
+		GetTextureParameteriv = reinterpret_cast<PFNGETTEXTUREPARAMETERIV>(IntGetProcAddress("glGetTextureParameteriv"));
+		if(!GetTextureParameteriv) ++numFailed;
+		GetTextureSubImage = reinterpret_cast<PFNGETTEXTURESUBIMAGE>(IntGetProcAddress("glGetTextureSubImage"));
+		if(!GetTextureSubImage) ++numFailed;
+		GetTransformFeedbacki64_v = reinterpret_cast<PFNGETTRANSFORMFEEDBACKI64_V>(IntGetProcAddress("glGetTransformFeedbacki64_v"));
+		if(!GetTransformFeedbacki64_v) ++numFailed;
+		GetTransformFeedbacki_v = reinterpret_cast<PFNGETTRANSFORMFEEDBACKI_V>(IntGetProcAddress("glGetTransformFeedbacki_v"));
+		if(!GetTransformFeedbacki_v) ++numFailed;
+		GetTransformFeedbackiv = reinterpret_cast<PFNGETTRANSFORMFEEDBACKIV>(IntGetProcAddress("glGetTransformFeedbackiv"));
+		if(!GetTransformFeedbackiv) ++numFailed;
+		GetVertexArrayIndexed64iv = reinterpret_cast<PFNGETVERTEXARRAYINDEXED64IV>(IntGetProcAddress("glGetVertexArrayIndexed64iv"));
+		if(!GetVertexArrayIndexed64iv) ++numFailed;
+		GetVertexArrayIndexediv = reinterpret_cast<PFNGETVERTEXARRAYINDEXEDIV>(IntGetProcAddress("glGetVertexArrayIndexediv"));
+		if(!GetVertexArrayIndexediv) ++numFailed;
+		GetVertexArrayiv = reinterpret_cast<PFNGETVERTEXARRAYIV>(IntGetProcAddress("glGetVertexArrayiv"));
+		if(!GetVertexArrayiv) ++numFailed;
+		InvalidateNamedFramebufferData = reinterpret_cast<PFNINVALIDATENAMEDFRAMEBUFFERDATA>(IntGetProcAddress("glInvalidateNamedFramebufferData"));
+		if(!InvalidateNamedFramebufferData) ++numFailed;
+		InvalidateNamedFramebufferSubData = reinterpret_cast<PFNINVALIDATENAMEDFRAMEBUFFERSUBDATA>(IntGetProcAddress("glInvalidateNamedFramebufferSubData"));
+		if(!InvalidateNamedFramebufferSubData) ++numFailed;
+		MapNamedBuffer = reinterpret_cast<PFNMAPNAMEDBUFFER>(IntGetProcAddress("glMapNamedBuffer"));
+		if(!MapNamedBuffer) ++numFailed;
+		MapNamedBufferRange = reinterpret_cast<PFNMAPNAMEDBUFFERRANGE>(IntGetProcAddress("glMapNamedBufferRange"));
+		if(!MapNamedBufferRange) ++numFailed;
+		NamedBufferData = reinterpret_cast<PFNNAMEDBUFFERDATA>(IntGetProcAddress("glNamedBufferData"));
+		if(!NamedBufferData) ++numFailed;
+		NamedBufferStorage = reinterpret_cast<PFNNAMEDBUFFERSTORAGE>(IntGetProcAddress("glNamedBufferStorage"));
+		if(!NamedBufferStorage) ++numFailed;
+		NamedBufferSubData = reinterpret_cast<PFNNAMEDBUFFERSUBDATA>(IntGetProcAddress("glNamedBufferSubData"));
+		if(!NamedBufferSubData) ++numFailed;
+		NamedFramebufferDrawBuffer = reinterpret_cast<PFNNAMEDFRAMEBUFFERDRAWBUFFER>(IntGetProcAddress("glNamedFramebufferDrawBuffer"));
+		if(!NamedFramebufferDrawBuffer) ++numFailed;
+		NamedFramebufferDrawBuffers = reinterpret_cast<PFNNAMEDFRAMEBUFFERDRAWBUFFERS>(IntGetProcAddress("glNamedFramebufferDrawBuffers"));
+		if(!NamedFramebufferDrawBuffers) ++numFailed;
+		NamedFramebufferParameteri = reinterpret_cast<PFNNAMEDFRAMEBUFFERPARAMETERI>(IntGetProcAddress("glNamedFramebufferParameteri"));
+		if(!NamedFramebufferParameteri) ++numFailed;
+		NamedFramebufferReadBuffer = reinterpret_cast<PFNNAMEDFRAMEBUFFERREADBUFFER>(IntGetProcAddress("glNamedFramebufferReadBuffer"));
+		if(!NamedFramebufferReadBuffer) ++numFailed;
+		NamedFramebufferRenderbuffer = reinterpret_cast<PFNNAMEDFRAMEBUFFERRENDERBUFFER>(IntGetProcAddress("glNamedFramebufferRenderbuffer"));
+		if(!NamedFramebufferRenderbuffer) ++numFailed;
+		NamedFramebufferTexture = reinterpret_cast<PFNNAMEDFRAMEBUFFERTEXTURE>(IntGetProcAddress("glNamedFramebufferTexture"));
+		if(!NamedFramebufferTexture) ++numFailed;
+		NamedFramebufferTextureLayer = reinterpret_cast<PFNNAMEDFRAMEBUFFERTEXTURELAYER>(IntGetProcAddress("glNamedFramebufferTextureLayer"));
+		if(!NamedFramebufferTextureLayer) ++numFailed;
+		NamedRenderbufferStorage = reinterpret_cast<PFNNAMEDRENDERBUFFERSTORAGE>(IntGetProcAddress("glNamedRenderbufferStorage"));
+		if(!NamedRenderbufferStorage) ++numFailed;
+		NamedRenderbufferStorageMultisample = reinterpret_cast<PFNNAMEDRENDERBUFFERSTORAGEMULTISAMPLE>(IntGetProcAddress("glNamedRenderbufferStorageMultisample"));
+		if(!NamedRenderbufferStorageMultisample) ++numFailed;
+		TextureBuffer = reinterpret_cast<PFNTEXTUREBUFFER>(IntGetProcAddress("glTextureBuffer"));
+		if(!TextureBuffer) ++numFailed;
+		TextureBufferRange = reinterpret_cast<PFNTEXTUREBUFFERRANGE>(IntGetProcAddress("glTextureBufferRange"));
+		if(!TextureBufferRange) ++numFailed;
+		TextureParameterIiv = reinterpret_cast<PFNTEXTUREPARAMETERIIV>(IntGetProcAddress("glTextureParameterIiv"));
+		if(!TextureParameterIiv) ++numFailed;
+		TextureParameterIuiv = reinterpret_cast<PFNTEXTUREPARAMETERIUIV>(IntGetProcAddress("glTextureParameterIuiv"));
+		if(!TextureParameterIuiv) ++numFailed;
+		TextureParameterf = reinterpret_cast<PFNTEXTUREPARAMETERF>(IntGetProcAddress("glTextureParameterf"));
+		if(!TextureParameterf) ++numFailed;
+		TextureParameterfv = reinterpret_cast<PFNTEXTUREPARAMETERFV>(IntGetProcAddress("glTextureParameterfv"));
+		if(!TextureParameterfv) ++numFailed;
+		TextureParameteri = reinterpret_cast<PFNTEXTUREPARAMETERI>(IntGetProcAddress("glTextureParameteri"));
+		if(!TextureParameteri) ++numFailed;
+		TextureParameteriv = reinterpret_cast<PFNTEXTUREPARAMETERIV>(IntGetProcAddress("glTextureParameteriv"));
+		if(!TextureParameteriv) ++numFailed;
+		TextureStorage1D = reinterpret_cast<PFNTEXTURESTORAGE1D>(IntGetProcAddress("glTextureStorage1D"));
+		if(!TextureStorage1D) ++numFailed;
+		TextureStorage2D = reinterpret_cast<PFNTEXTURESTORAGE2D>(IntGetProcAddress("glTextureStorage2D"));
+		if(!TextureStorage2D) ++numFailed;
+		TextureStorage2DMultisample = reinterpret_cast<PFNTEXTURESTORAGE2DMULTISAMPLE>(IntGetProcAddress("glTextureStorage2DMultisample"));
+		if(!TextureStorage2DMultisample) ++numFailed;
+		TextureStorage3D = reinterpret_cast<PFNTEXTURESTORAGE3D>(IntGetProcAddress("glTextureStorage3D"));
+		if(!TextureStorage3D) ++numFailed;
+		TextureStorage3DMultisample = reinterpret_cast<PFNTEXTURESTORAGE3DMULTISAMPLE>(IntGetProcAddress("glTextureStorage3DMultisample"));
+		if(!TextureStorage3DMultisample) ++numFailed;
+		TextureSubImage1D = reinterpret_cast<PFNTEXTURESUBIMAGE1D>(IntGetProcAddress("glTextureSubImage1D"));
+		if(!TextureSubImage1D) ++numFailed;
+		TextureSubImage2D = reinterpret_cast<PFNTEXTURESUBIMAGE2D>(IntGetProcAddress("glTextureSubImage2D"));
+		if(!TextureSubImage2D) ++numFailed;
+		TextureSubImage3D = reinterpret_cast<PFNTEXTURESUBIMAGE3D>(IntGetProcAddress("glTextureSubImage3D"));
+		if(!TextureSubImage3D) ++numFailed;
+		TransformFeedbackBufferBase = reinterpret_cast<PFNTRANSFORMFEEDBACKBUFFERBASE>(IntGetProcAddress("glTransformFeedbackBufferBase"));
+		if(!TransformFeedbackBufferBase) ++numFailed;
+		TransformFeedbackBufferRange = reinterpret_cast<PFNTRANSFORMFEEDBACKBUFFERRANGE>(IntGetProcAddress("glTransformFeedbackBufferRange"));
+		if(!TransformFeedbackBufferRange) ++numFailed;
+		UnmapNamedBuffer = reinterpret_cast<PFNUNMAPNAMEDBUFFER>(IntGetProcAddress("glUnmapNamedBuffer"));
+		if(!UnmapNamedBuffer) ++numFailed;
+		VertexArrayAttribBinding = reinterpret_cast<PFNVERTEXARRAYATTRIBBINDING>(IntGetProcAddress("glVertexArrayAttribBinding"));
+		if(!VertexArrayAttribBinding) ++numFailed;
+		VertexArrayAttribFormat = reinterpret_cast<PFNVERTEXARRAYATTRIBFORMAT>(IntGetProcAddress("glVertexArrayAttribFormat"));
+		if(!VertexArrayAttribFormat) ++numFailed;
+		VertexArrayAttribIFormat = reinterpret_cast<PFNVERTEXARRAYATTRIBIFORMAT>(IntGetProcAddress("glVertexArrayAttribIFormat"));
+		if(!VertexArrayAttribIFormat) ++numFailed;
+		VertexArrayAttribLFormat = reinterpret_cast<PFNVERTEXARRAYATTRIBLFORMAT>(IntGetProcAddress("glVertexArrayAttribLFormat"));
+		if(!VertexArrayAttribLFormat) ++numFailed;
+		VertexArrayBindingDivisor = reinterpret_cast<PFNVERTEXARRAYBINDINGDIVISOR>(IntGetProcAddress("glVertexArrayBindingDivisor"));
+		if(!VertexArrayBindingDivisor) ++numFailed;
+		VertexArrayElementBuffer = reinterpret_cast<PFNVERTEXARRAYELEMENTBUFFER>(IntGetProcAddress("glVertexArrayElementBuffer"));
+		if(!VertexArrayElementBuffer) ++numFailed;
+		VertexArrayVertexBuffer = reinterpret_cast<PFNVERTEXARRAYVERTEXBUFFER>(IntGetProcAddress("glVertexArrayVertexBuffer"));
+		if(!VertexArrayVertexBuffer) ++numFailed;
+		VertexArrayVertexBuffers = reinterpret_cast<PFNVERTEXARRAYVERTEXBUFFERS>(IntGetProcAddress("glVertexArrayVertexBuffers"));
+		if(!VertexArrayVertexBuffers) ++numFailed;
+		return numFailed;
+	}
+	
 	typedef void (CODEGEN_FUNCPTR *PFNBLENDFUNC)(GLenum, GLenum);
 	PFNBLENDFUNC BlendFunc = 0;
 	typedef void (CODEGEN_FUNCPTR *PFNCLEAR)(GLbitfield);
@@ -2282,11 +2702,15 @@ namespace gl
 			
 			void InitializeMappingTable(std::vector<MapEntry> &table)
 			{
-				table.reserve(0);
+				table.reserve(2);
+				table.push_back(MapEntry("GL_ARB_buffer_storage", &exts::var_ARB_buffer_storage, Load_ARB_buffer_storage));
+				table.push_back(MapEntry("GL_ARB_direct_state_access", &exts::var_ARB_direct_state_access, Load_ARB_direct_state_access));
 			}
 			
 			void ClearExtensionVars()
 			{
+				exts::var_ARB_buffer_storage = exts::LoadTest();
+				exts::var_ARB_direct_state_access = exts::LoadTest();
 			}
 			
 			void LoadExtByName(std::vector<MapEntry> &table, const char *extensionName)
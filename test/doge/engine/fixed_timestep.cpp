@@ -0,0 +1,47 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+
+TEST_CASE("a frame takes every step that is due, and keeps what's left over")
+{
+   auto const timestep = doge::fixed_timestep{100.0};
+   auto accumulator = 0.035;
+   CHECK(timestep.consume(accumulator) == 3);
+   CHECK(accumulator == Approx(0.005));
+
+   accumulator += 0.004;
+   CHECK(timestep.consume(accumulator) == 0);
+   CHECK(accumulator == Approx(0.009));
+
+   accumulator += 0.001;
+   CHECK(timestep.consume(accumulator) == 1);
+   CHECK(std::abs(accumulator) < 1e-12);
+}
+
+TEST_CASE("a long stall takes at most max_steps, and drops the rest")
+{
+   auto const timestep = doge::fixed_timestep{100.0, 4};
+   auto accumulator = 2.0 + 0.0075;
+   CHECK(timestep.consume(accumulator) == 4);
+   CHECK(accumulator < timestep.step());
+   CHECK(accumulator == Approx(0.0075));
+
+   // The next frame carries on as normal, rather than trying to catch up.
+   accumulator += 0.01;
+   CHECK(timestep.consume(accumulator) == 1);
+   CHECK(accumulator == Approx(0.0075));
+}
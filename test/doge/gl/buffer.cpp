@@ -0,0 +1,152 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/buffer.hpp>
+#include <doge/gl/direct_state_access.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <doge/gl/vertex_array.hpp>
+#include <doge/types.hpp>
+#include <vector>
+
+using elements = doge::element_array_buffer<doge::basic_buffer_usage::static_draw>;
+
+namespace {
+   template <typename T>
+   std::vector<T> read(GLuint const buffer, std::size_t const bytes)
+   {
+      auto result = std::vector<T>(bytes / sizeof(T));
+      doge::state_cache::bind_buffer(gl::COPY_READ_BUFFER, buffer);
+      gl::GetBufferSubData(gl::COPY_READ_BUFFER, 0, bytes, result.data());
+      return result;
+   }
+
+   template <typename Index>
+   std::vector<Index> read(elements const& buffer)
+   {
+      return read<Index>(buffer.get()[0], buffer.size());
+   }
+} // namespace <anonymous>
+
+TEST_CASE("indices that fit in 16 bits are stored in 16 bits")
+{
+   auto engine = doge::engine{};
+   auto buffer = elements{};
+   auto const small = std::vector<GLuint>{0, 1, 2, 65'535};
+   buffer.write(small);
+   CHECK(buffer.index_type() == gl::UNSIGNED_SHORT);
+   CHECK(buffer.size() == 4 * sizeof(GLushort));
+   CHECK(read<GLushort>(buffer) == std::vector<GLushort>{0, 1, 2, 65'535});
+
+   buffer.write(1, gsl::span<GLuint const>{std::vector<GLuint>{7, 8}});
+   buffer.flush();
+   CHECK(read<GLushort>(buffer) == std::vector<GLushort>{0, 7, 8, 65'535});
+
+   auto const large = std::vector<GLuint>{0, 1, 65'536};
+   buffer.write(large);
+   CHECK(buffer.index_type() == gl::UNSIGNED_INT);
+   CHECK(read<GLuint>(buffer) == large);
+}
+
+TEST_CASE("a partial write that doesn't fit the index type widens the whole buffer")
+{
+   auto engine = doge::engine{};
+   for (auto const dsa : {false, true}) {
+      doge::direct_state_access::enabled(dsa);
+      auto buffer = elements{};
+      auto const indices = std::vector<GLuint>{0, 1, 2, 3};
+      buffer.write(indices);
+      REQUIRE(buffer.index_type() == gl::UNSIGNED_SHORT);
+
+      // The staged write must survive the buffer being rewritten.
+      buffer.write(1, gsl::span<GLuint const>{std::vector<GLuint>{9}});
+      buffer.write(2, gsl::span<GLuint const>{std::vector<GLuint>{70'000}});
+      buffer.flush();
+      CHECK(buffer.index_type() == gl::UNSIGNED_INT);
+      CHECK(buffer.size() == 4 * sizeof(GLuint));
+      CHECK(read<GLuint>(buffer) == std::vector<GLuint>{0, 9, 70'000, 3});
+
+      auto const bytes = std::vector<GLubyte>{0, 1, 2};
+      buffer.write(gsl::span<GLubyte const>{bytes});
+      buffer.write(0, gsl::span<GLuint const>{std::vector<GLuint>{300}});
+      CHECK(buffer.index_type() == gl::UNSIGNED_SHORT);
+      CHECK(read<GLushort>(buffer) == std::vector<GLushort>{300, 1, 2});
+   }
+}
+
+TEST_CASE("widening one mesh's elements leaves the bound vertex array's element buffer alone")
+{
+   auto engine = doge::engine{};
+   doge::direct_state_access::enabled(false);
+   using mesh_type = doge::vertex_element_buffer<doge::basic_buffer_usage::static_draw,
+      doge::vec3>;
+   auto const vertices = std::vector<doge::std_layout_tuple<doge::vec3>>(3);
+   auto const indices = std::vector<GLuint>{0, 1, 2};
+   auto widened = mesh_type{vertices, indices};
+   auto bound = mesh_type{vertices, indices};
+
+   auto const element_buffer = [](auto const& mesh) {
+      auto result = GLint{};
+      mesh.bind([&result]{ gl::GetIntegerv(gl::ELEMENT_ARRAY_BUFFER_BINDING, &result); });
+      return result;
+   };
+   auto const widened_elements = element_buffer(widened);
+   auto const bound_elements = element_buffer(bound);
+   REQUIRE(widened_elements != bound_elements);
+
+   // bound's vertex array stays bound while widened is read back and rewritten.
+   widened.write(1, gsl::span<GLuint const>{std::vector<GLuint>{70'000}});
+   auto current = GLint{};
+   gl::GetIntegerv(gl::ELEMENT_ARRAY_BUFFER_BINDING, &current);
+   CHECK(current == bound_elements);
+   CHECK(element_buffer(widened) == widened_elements);
+}
+
+TEST_CASE("byte indices are only used when they're asked for")
+{
+   auto engine = doge::engine{};
+   auto buffer = elements{};
+   auto const bytes = std::vector<GLubyte>{0, 1, 2};
+   buffer.write(gsl::span<GLubyte const>{bytes});
+   CHECK(buffer.index_type() == gl::UNSIGNED_BYTE);
+   CHECK(read<GLubyte>(buffer) == bytes);
+}
+
+TEST_CASE("a structure of arrays keeps each member in a stream that's written separately")
+{
+   auto engine = doge::engine{};
+   auto buffer = doge::basic_buffer<doge::resource_type::buffer, doge::basic_buffer_type::array,
+      doge::basic_buffer_usage::dynamic_draw, doge::basic_buffer_layout::structure_of_arrays,
+      GLfloat, GLint>{};
+   static_assert(decltype(buffer)::streams == 2);
+
+   auto const floats = std::vector<GLfloat>{0.5f, 1.5f, 2.5f};
+   auto const ints = std::vector<GLint>{1, 2, 3};
+   buffer.write(floats, ints);
+   CHECK(buffer.size(0) == 3 * sizeof(GLfloat));
+   CHECK(buffer.size(1) == 3 * sizeof(GLint));
+   CHECK(buffer[0] != buffer[1]);
+
+   auto const more = std::vector<GLint>{4, 5, 6, 7, 8};
+   buffer.write<1>(gsl::span<GLint const>{more});
+   CHECK(buffer.size(0) == 3 * sizeof(GLfloat));
+   CHECK(buffer.size(1) == 5 * sizeof(GLint));
+   CHECK(read<GLfloat>(buffer[0], buffer.size(0)) == floats);
+   CHECK(read<GLint>(buffer[1], buffer.size(1)) == more);
+
+   buffer.write<0>(1, gsl::span<GLfloat const>{std::vector<GLfloat>{9.0f}});
+   CHECK(read<GLfloat>(buffer[0], buffer.size(0)) == std::vector<GLfloat>{0.5f, 9.0f, 2.5f});
+}
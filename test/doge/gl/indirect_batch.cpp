@@ -0,0 +1,79 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/indirect_batch.hpp>
+#include <doge/gl/render_queue.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+   doge::draw_call indexed(GLuint const vertex_array, GLsizei const instances = 1)
+   {
+      auto result = doge::draw_call{};
+      result.program = 1;
+      result.vertex_array = vertex_array;
+      result.index_type = gl::UNSIGNED_INT;
+      result.count = 6;
+      result.instances = instances;
+      return result;
+   }
+} // namespace <anonymous>
+
+TEST_CASE("draws that share state are recorded into the same bucket")
+{
+   auto engine = doge::engine{};
+   auto queue = doge::render_queue{};
+   queue.submit(indexed(1), 0, 0.1f);
+   queue.submit(indexed(2), 0, 0.2f);
+   queue.submit(indexed(1), 0, 0.3f);
+
+   auto arrays = indexed(1);
+   arrays.index_type = gl::NONE;
+   queue.submit(arrays, 0, 0.4f);
+
+   auto batch = doge::indirect_batch{};
+   batch.record(queue);
+   CHECK(queue.empty());
+   CHECK(batch.size() == 4);
+   CHECK(batch.buckets() == 3);
+
+   batch.clear();
+   CHECK(batch.size() == 0);
+   CHECK(batch.buckets() == 0);
+}
+
+TEST_CASE("each draw is given a slot per instance, in the order that the draws are issued")
+{
+   auto engine = doge::engine{};
+   auto queue = doge::render_queue{};
+   auto first = indexed(1, 3);
+   first.user = 7;
+   auto second = indexed(1);
+   second.user = 8;
+   queue.submit(second, 0, 0.9f);
+   queue.submit(first, 0, 0.1f);
+
+   auto batch = doge::indirect_batch{};
+   auto slots = std::vector<std::pair<std::uint32_t, GLuint>>{};
+   batch.record(queue, [&slots](doge::draw_call const& draw, GLuint const slot) {
+      slots.emplace_back(draw.user, slot); });
+
+   CHECK(slots == std::vector<std::pair<std::uint32_t, GLuint>>{{7, 0}, {8, 3}});
+   CHECK(batch.slots() == 4);
+   CHECK(batch.buckets() == 1);
+}
@@ -0,0 +1,84 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/memory.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using buffer_pool = doge::name_pool<doge::resource_type::buffer>;
+
+TEST_CASE("gpu_ptr is only as big as its names")
+{
+   static_assert(sizeof(doge::gpu_ptr<doge::resource_type::buffer>) == sizeof(GLuint));
+   static_assert(sizeof(doge::gpu_ptr<doge::resource_type::buffer, 3>) == 3 * sizeof(GLuint));
+   static_assert(std::is_nothrow_move_constructible_v<doge::gpu_ptr<doge::resource_type::buffer>>);
+   static_assert(std::is_nothrow_move_assignable_v<doge::gpu_ptr<doge::resource_type::buffer>>);
+}
+
+TEST_CASE("names are made a batch at a time")
+{
+   auto engine = doge::engine{};
+   auto const a = doge::gpu_ptr<doge::resource_type::buffer>{};
+   CHECK(buffer_pool::available() == buffer_pool::batch_size - 1);
+
+   auto const b = doge::gpu_ptr<doge::resource_type::buffer, 2>{};
+   CHECK(buffer_pool::available() == buffer_pool::batch_size - 3);
+   CHECK(*a != b[0]);
+   CHECK(b[0] != b[1]);
+}
+
+TEST_CASE("moving a gpu_ptr moves its names, and releases the old ones once")
+{
+   auto engine = doge::engine{};
+   auto a = doge::gpu_ptr<doge::resource_type::buffer>{};
+   auto const name = *a;
+
+   auto b = std::move(a);
+   CHECK(*b == name);
+   CHECK(*a == 0);
+
+   auto c = doge::gpu_ptr<doge::resource_type::buffer>{};
+   auto const released = buffer_pool::released();
+   c = std::move(b);
+   CHECK(*c == name);
+   CHECK(buffer_pool::released() == released + 1);
+}
+
+TEST_CASE("released names are deleted together")
+{
+   auto engine = doge::engine{};
+   buffer_pool::collect();
+
+   auto names = std::vector<GLuint>{};
+   {
+      auto buffers = std::vector<doge::gpu_ptr<doge::resource_type::buffer>>(3);
+      for (auto const& b : buffers) {
+         names.push_back(*b);
+         gl::BindBuffer(gl::COPY_WRITE_BUFFER, *b);
+      }
+   }
+
+   CHECK(buffer_pool::released() == 3);
+   for (auto const name : names)
+      CHECK(gl::IsBuffer(name));
+
+   buffer_pool::collect();
+   CHECK(buffer_pool::released() == 0);
+   for (auto const name : names)
+      CHECK(not gl::IsBuffer(name));
+}
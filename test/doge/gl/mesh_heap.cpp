@@ -0,0 +1,130 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/direct_state_access.hpp>
+#include <doge/gl/mesh_heap.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <doge/types.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace {
+   using heap_type = doge::mesh_heap<doge::vec3, doge::vec2>;
+   using vertex = heap_type::vertex_type;
+
+   std::vector<vertex> triangle(float const z)
+   {
+      return {vertex{doge::vec3{0.0f, 0.0f, z}, doge::vec2{0.0f, 0.0f}},
+              vertex{doge::vec3{1.0f, 0.0f, z}, doge::vec2{1.0f, 0.0f}},
+              vertex{doge::vec3{0.0f, 1.0f, z}, doge::vec2{0.0f, 1.0f}}};
+   }
+
+   std::vector<std::byte> read(GLuint const buffer, std::size_t const offset,
+      std::size_t const bytes)
+   {
+      auto result = std::vector<std::byte>(bytes);
+      doge::state_cache::bind_buffer(gl::COPY_READ_BUFFER, buffer);
+      gl::GetBufferSubData(gl::COPY_READ_BUFFER, static_cast<GLintptr>(offset),
+         static_cast<GLsizeiptr>(bytes), result.data());
+      return result;
+   }
+
+   template <typename T>
+   bool holds(GLuint const buffer, std::size_t const offset, std::vector<T> const& expected)
+   {
+      auto const bytes = std::size(expected) * sizeof(T);
+      auto const actual = read(buffer, offset, bytes);
+      return std::memcmp(actual.data(), expected.data(), bytes) == 0;
+   }
+} // namespace <anonymous>
+
+TEST_CASE("meshes are addressed by a base vertex, and survive the heap growing")
+{
+   auto engine = doge::engine{};
+   for (auto const dsa : {false, true}) {
+      doge::direct_state_access::enabled(dsa);
+      auto heap = heap_type{4, 4};
+      CHECK(heap.vertex_capacity() == 4);
+      CHECK(heap.element_capacity() == 4);
+
+      auto const first_vertices = triangle(1.0f);
+      auto const first_elements = std::vector<GLuint>{0, 1, 2};
+      auto const first = heap.allocate(first_vertices, first_elements);
+      CHECK(first.indexed());
+      CHECK(first.count == 3);
+      CHECK(first.base_vertex == static_cast<GLint>(first.vertices.offset / sizeof(vertex)));
+
+      auto const vertex_buffer = heap.vertex_buffer();
+      auto const element_buffer = heap.element_buffer();
+
+      // Neither buffer has room for a second triangle, so both grow.
+      auto const second_vertices = triangle(2.0f);
+      auto const second_elements = std::vector<GLuint>{2, 1, 0};
+      auto const second = heap.allocate(second_vertices, second_elements);
+      CHECK(heap.vertex_capacity() >= 6);
+      CHECK(heap.element_capacity() >= 6);
+      CHECK(heap.vertex_buffer() != vertex_buffer);
+      CHECK(heap.element_buffer() != element_buffer);
+
+      // The old buffers were deleted as soon as they were replaced.
+      CHECK(not gl::IsBuffer(vertex_buffer));
+      CHECK(not gl::IsBuffer(element_buffer));
+
+      CHECK(second.vertices.offset % sizeof(vertex) == 0);
+      CHECK(second.base_vertex == static_cast<GLint>(second.vertices.offset / sizeof(vertex)));
+      CHECK(second.first_index == static_cast<GLintptr>(second.elements.offset));
+
+      // The first mesh was copied into the new buffers, and the second didn't overwrite it.
+      CHECK(holds(heap.vertex_buffer(), first.vertices.offset, first_vertices));
+      CHECK(holds(heap.element_buffer(), first.elements.offset, first_elements));
+      CHECK(holds(heap.vertex_buffer(), second.vertices.offset, second_vertices));
+      CHECK(holds(heap.element_buffer(), second.elements.offset, second_elements));
+
+      // The vertex array was pointed at the new buffers.
+      heap.bind([&heap]{
+         for (auto location = GLuint{0}; location < 2; ++location) {
+            auto binding = GLint{};
+            gl::GetVertexAttribiv(location, gl::VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &binding);
+            CHECK(binding == static_cast<GLint>(heap.vertex_buffer()));
+         }
+
+         auto elements = GLint{};
+         gl::GetIntegerv(gl::ELEMENT_ARRAY_BUFFER_BINDING, &elements);
+         CHECK(elements == static_cast<GLint>(heap.element_buffer()));
+      });
+
+      auto const call = heap.as_draw_call(second);
+      CHECK(call.base_vertex == second.base_vertex);
+      CHECK(call.first == second.first_index);
+      CHECK(call.count == 3);
+   }
+}
+
+TEST_CASE("unindexed meshes are drawn from their base vertex")
+{
+   auto engine = doge::engine{};
+   auto heap = heap_type{3, 1};
+   auto const first = heap.allocate(triangle(1.0f));
+   auto const second = heap.allocate(triangle(2.0f));
+   CHECK(not second.indexed());
+   CHECK(second.count == 3);
+   CHECK(second.base_vertex == static_cast<GLint>(second.vertices.offset / sizeof(vertex)));
+   CHECK(second.base_vertex != first.base_vertex);
+   CHECK(heap.as_draw_call(second).first == second.base_vertex);
+   CHECK(holds(heap.vertex_buffer(), first.vertices.offset, triangle(1.0f)));
+}
@@ -0,0 +1,127 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/gl/packed_attributes.hpp>
+#include <doge/gl/vertex_array.hpp>
+#include <doge/types.hpp>
+#include <cmath>
+#include <cstdint>
+#include <gsl/gsl>
+#include <limits>
+#include <vector>
+
+TEST_CASE("a packed position, normal, and texture coordinate takes half the space")
+{
+   using doge::detail::attribute_traits;
+   static_assert(sizeof(doge::std_layout_tuple<doge::half4, doge::snorm_10_10_10_2, doge::half2>)
+      == sizeof(doge::std_layout_tuple<doge::vec3, doge::vec3, doge::vec2>) / 2);
+   static_assert(attribute_traits<doge::half4>::type == gl::HALF_FLOAT);
+   static_assert(attribute_traits<doge::unorm8x4>::normalised);
+   static_assert(attribute_traits<doge::snorm_10_10_10_2>::components == 4);
+   static_assert(not attribute_traits<doge::vec3>::normalised);
+}
+
+TEST_CASE("floats round to the nearest half, and back")
+{
+   CHECK(doge::half{1.0f}.bits == 0x3c00);
+   CHECK(doge::half{-2.5f}.bits == 0xc100);
+   CHECK(doge::half{65'504.0f}.bits == 0x7bff);
+   CHECK(doge::half{1.0e5f}.bits == 0x7c00);
+   CHECK(doge::half{-0.0f}.bits == 0x8000);
+   CHECK(doge::half{std::numeric_limits<float>::quiet_NaN()}.bits == 0x7e00);
+
+   // Ties go to even: 1 + 2^-11 is halfway between 1 and the next half.
+   CHECK(doge::half{1.0f + std::ldexp(1.0f, -11)}.bits == 0x3c00);
+   CHECK(doge::half{1.0f + 3 * std::ldexp(1.0f, -11)}.bits == 0x3c02);
+
+   // The smallest denormal.
+   CHECK(doge::half{std::ldexp(1.0f, -24)}.bits == 0x0001);
+   CHECK(static_cast<float>(doge::half{std::ldexp(1.0f, -24)}) == std::ldexp(1.0f, -24));
+
+   for (auto const f : {0.0f, 0.5f, -3.25f, 1'024.0f, 0.000'122'070'312'5f})
+      CHECK(static_cast<float>(doge::half{f}) == f);
+}
+
+TEST_CASE("every half survives a round trip through a float")
+{
+   for (auto bits = std::uint32_t{0}; bits <= 0xffff; ++bits) {
+      auto h = doge::half{};
+      h.bits = gsl::narrow_cast<std::uint16_t>(bits);
+      auto const f = static_cast<float>(h);
+
+      // NaNs keep their sign and stay NaNs, but not their payload.
+      if ((bits & 0x7c00) == 0x7c00 && (bits & 0x03ff) != 0) {
+         CHECK(std::isnan(f));
+         CHECK((doge::half{f}.bits & 0x7fff) == 0x7e00);
+         continue;
+      }
+
+      CHECK(doge::half{f}.bits == bits);
+   }
+}
+
+TEST_CASE("infinities, denormals, and ties are converted exactly")
+{
+   constexpr auto infinity = std::numeric_limits<float>::infinity();
+   CHECK(doge::half{infinity}.bits == 0x7c00);
+   CHECK(doge::half{-infinity}.bits == 0xfc00);
+   CHECK(static_cast<float>(doge::half{infinity}) == infinity);
+   CHECK(static_cast<float>(doge::half{-infinity}) == -infinity);
+
+   // 65520 is halfway between the largest half and 2^16, so it rounds up to infinity.
+   CHECK(doge::half{65'519.0f}.bits == 0x7bff);
+   CHECK(doge::half{65'520.0f}.bits == 0x7c00);
+
+   // The largest denormal, and the smallest normal.
+   CHECK(doge::half{std::ldexp(1023.0f, -24)}.bits == 0x03ff);
+   CHECK(doge::half{std::ldexp(1.0f, -14)}.bits == 0x0400);
+
+   // Denormals round to the nearest multiple of 2^-24, ties to even.
+   CHECK(doge::half{std::ldexp(1.0f, -25)}.bits == 0x0000);
+   CHECK(doge::half{std::ldexp(3.0f, -25)}.bits == 0x0002);
+   CHECK(doge::half{std::ldexp(5.0f, -25)}.bits == 0x0002);
+   CHECK(doge::half{-std::ldexp(1.5f, -24)}.bits == 0x8002);
+   CHECK(doge::half{std::ldexp(1.0f, -30)}.bits == 0x0000);
+
+   // Normals round to the nearest ten-bit mantissa, ties to even.
+   CHECK(doge::half{1.0f + std::ldexp(1.0f, -12)}.bits == 0x3c00);
+   CHECK(doge::half{1.0f + std::ldexp(3.0f, -12)}.bits == 0x3c01);
+   CHECK(doge::half{2.0f - std::ldexp(1.0f, -12)}.bits == 0x4000);
+}
+
+TEST_CASE("to_halves converts a whole range")
+{
+   auto const in = std::vector<float>{1.0f, 2.0f, 0.5f, -1.0f};
+   auto out = std::vector<doge::half>(4);
+   doge::to_halves(in, out);
+   for (auto i = std::size_t{0}; i < in.size(); ++i)
+      CHECK(out[i].bits == doge::half{in[i]}.bits);
+}
+
+TEST_CASE("normalised integers are clamped and rounded")
+{
+   auto const colour = doge::unorm8x4{doge::vec4{0.5f, 2.0f, -1.0f, 1.0f}};
+   CHECK(colour.value[0] == 128);
+   CHECK(colour.value[1] == 255);
+   CHECK(colour.value[2] == 0);
+   CHECK(colour.value[3] == 255);
+
+   auto const normal = doge::snorm_10_10_10_2{doge::vec4{1.0f, -1.0f, 0.0f, -1.0f}};
+   CHECK((normal.bits & 0x3ff) == 511);
+   CHECK(((normal.bits >> 10) & 0x3ff) == 0x201);
+   CHECK(((normal.bits >> 20) & 0x3ff) == 0);
+   CHECK((normal.bits >> 30) == 3);
+}
@@ -0,0 +1,88 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/gl/render_queue.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+TEST_CASE("opaque keys group by state, and then order front-to-back")
+{
+   using doge::draw_key;
+   auto const near = draw_key::opaque(0, 1, 7, 3, 0.1f);
+   auto const far = draw_key::opaque(0, 1, 7, 3, 0.9f);
+   CHECK(near < far);
+
+   // State outranks depth.
+   CHECK(draw_key::opaque(0, 1, 7, 3, 0.9f) < draw_key::opaque(0, 2, 7, 3, 0.1f));
+   CHECK(draw_key::opaque(0, 1, 7, 3, 0.9f) < draw_key::opaque(0, 1, 8, 3, 0.1f));
+   CHECK(draw_key::opaque(0, 1, 7, 3, 0.9f) < draw_key::opaque(0, 1, 7, 4, 0.1f));
+
+   // Pass outranks everything.
+   CHECK(draw_key::opaque(0, 2'000, 60'000, 4'000, 1.0f) < draw_key::opaque(1, 0, 0, 0, 0.0f));
+   CHECK(far.pass() == 0);
+   CHECK(not far.is_translucent());
+}
+
+TEST_CASE("translucent keys follow their pass's opaque keys, and order back-to-front")
+{
+   using doge::draw_key;
+   auto const near = draw_key::translucent(2, 1, 7, 3, 0.1f);
+   auto const far = draw_key::translucent(2, 9, 7, 3, 0.9f);
+   CHECK(far < near);
+   CHECK(draw_key::opaque(2, 2'000, 60'000, 4'000, 1.0f) < far);
+   CHECK(near < draw_key::opaque(3, 0, 0, 0, 0.0f));
+   CHECK(near.pass() == 2);
+   CHECK(near.is_translucent());
+}
+
+TEST_CASE("render_queue sorts by key, keeping submission order for equal keys")
+{
+   auto queue = doge::render_queue{};
+   auto engine = std::mt19937_64{42};
+   auto keys = std::vector<std::uint64_t>{};
+   for (auto i = std::uint32_t{0}; i < 1'000; ++i) {
+      // Only a few distinct keys, so that stability is tested.
+      auto const key = engine() % 64 << 40 | engine() % 4;
+      keys.push_back(key);
+
+      auto draw = doge::draw_call{};
+      draw.user = i;
+      queue.submit(doge::draw_key{key}, draw);
+   }
+
+   queue.sort();
+   REQUIRE(queue.size() == 1'000);
+
+   auto previous_key = std::uint64_t{0};
+   auto previous_user = std::uint32_t{0};
+   auto first = true;
+   queue.for_each([&](doge::draw_key const key, doge::draw_call const& draw) {
+      CHECK(key.value() == keys[draw.user]);
+      if (not first) {
+         CHECK(previous_key <= key.value());
+         if (previous_key == key.value())
+            CHECK(previous_user < draw.user);
+      }
+
+      first = false;
+      previous_key = key.value();
+      previous_user = draw.user;
+   });
+
+   queue.clear();
+   CHECK(queue.empty());
+}
@@ -0,0 +1,47 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <array>
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <gl/gl_core.hpp>
+
+TEST_CASE("indexed targets that the cache doesn't track go straight through to GL")
+{
+   auto engine = doge::engine{};
+   auto buffers = std::array<GLuint, 3>{};
+   gl::GenBuffers(static_cast<GLsizei>(std::size(buffers)), buffers.data());
+   auto const [vertices, uniforms, feedback] = buffers;
+
+   doge::state_cache::bind_buffer(gl::ARRAY_BUFFER, vertices);
+   doge::state_cache::bind_buffer_base(gl::UNIFORM_BUFFER, 0, uniforms);
+   doge::state_cache::bind_buffer_base(gl::TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+
+   auto binding = GLint{0};
+   gl::GetIntegeri_v(gl::TRANSFORM_FEEDBACK_BUFFER_BINDING, 0, &binding);
+   CHECK(static_cast<GLuint>(binding) == feedback);
+   gl::GetIntegerv(gl::TRANSFORM_FEEDBACK_BUFFER_BINDING, &binding);
+   CHECK(static_cast<GLuint>(binding) == feedback);
+
+   // Binding the untracked target mustn't have disturbed what the cache knows about the others.
+   auto const elided = doge::state_cache::elided_calls();
+   doge::state_cache::bind_buffer(gl::ARRAY_BUFFER, vertices);
+   doge::state_cache::bind_buffer_base(gl::UNIFORM_BUFFER, 0, uniforms);
+   CHECK(doge::state_cache::elided_calls() == elided + 2);
+
+   doge::state_cache::deleted_buffers(buffers);
+   gl::DeleteBuffers(static_cast<GLsizei>(std::size(buffers)), buffers.data());
+}
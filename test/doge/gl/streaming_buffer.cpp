@@ -0,0 +1,100 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/memory.hpp>
+#include <doge/gl/state_cache.hpp>
+#include <doge/gl/streaming_buffer.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace {
+   constexpr auto capacity = std::size_t{4};
+   constexpr auto regions = std::size_t{3};
+   constexpr auto region_bytes = GLsizeiptr{capacity * sizeof(GLuint)};
+
+   // The value that frame writes to element i of its region.
+   GLuint value(std::size_t const frame, std::size_t const i) noexcept
+   {
+      return static_cast<GLuint>(frame * 10 + i);
+   }
+} // namespace <anonymous>
+
+TEST_CASE("regions are written in turn, and wrap around to the first")
+{
+   auto engine = doge::engine{};
+   auto buffer = doge::streaming_buffer<GLuint>{capacity, regions};
+   CHECK(buffer.capacity() == capacity);
+
+   auto spans = std::vector<GLuint*>{};
+   for (auto frame = std::size_t{0}; frame < 2 * regions; ++frame) {
+      auto const region = frame % regions;
+      CHECK(buffer.first() == static_cast<GLint>(region * capacity));
+      CHECK(buffer.offset() == static_cast<GLintptr>(region * capacity * sizeof(GLuint)));
+
+      auto const span = buffer.map();
+      CHECK(span.size() == static_cast<std::ptrdiff_t>(capacity));
+      spans.push_back(span.data());
+      buffer.commit();
+   }
+
+   // Persistent buffers are mapped once, so each region is always at the same address.
+   if (doge::streaming_buffer<GLuint>::persistent()) {
+      for (auto frame = std::size_t{0}; frame < regions; ++frame) {
+         CHECK(spans[frame + regions] == spans[frame]);
+         CHECK(spans[frame] == spans[0] + frame * capacity);
+      }
+   }
+}
+
+TEST_CASE("wrapping around waits for the GPU to finish with the region")
+{
+   auto engine = doge::engine{};
+   auto buffer = doge::streaming_buffer<GLuint>{capacity, regions};
+
+   // Each frame's region is read by a copy on the GPU. If map() didn't wait for the fence when it
+   // wrapped around, a later frame could overwrite a region before its copy had run.
+   constexpr auto frames = 3 * regions;
+   auto copies = doge::gpu_ptr<doge::resource_type::buffer>{};
+   doge::state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *copies);
+   gl::BufferData(gl::COPY_WRITE_BUFFER, frames * region_bytes, nullptr, gl::STREAM_READ);
+
+   for (auto frame = std::size_t{0}; frame < frames; ++frame) {
+      auto const region = buffer.map();
+      for (auto i = std::size_t{0}; i < capacity; ++i)
+         region[static_cast<std::ptrdiff_t>(i)] = value(frame, i);
+      buffer.unmap();
+
+      doge::state_cache::bind_buffer(gl::COPY_READ_BUFFER, buffer.get());
+      doge::state_cache::bind_buffer(gl::COPY_WRITE_BUFFER, *copies);
+      gl::CopyBufferSubData(gl::COPY_READ_BUFFER, gl::COPY_WRITE_BUFFER, buffer.offset(),
+         static_cast<GLintptr>(frame) * region_bytes, region_bytes);
+      buffer.commit();
+   }
+
+   auto result = std::vector<GLuint>(frames * capacity);
+   doge::state_cache::bind_buffer(gl::COPY_READ_BUFFER, *copies);
+   gl::GetBufferSubData(gl::COPY_READ_BUFFER, 0, frames * region_bytes, result.data());
+
+   auto expected = std::vector<GLuint>{};
+   for (auto frame = std::size_t{0}; frame < frames; ++frame) {
+      for (auto i = std::size_t{0}; i < capacity; ++i)
+         expected.push_back(value(frame, i));
+   }
+
+   CHECK(result == expected);
+   CHECK(gl::GetError() == gl::NO_ERROR_);
+}
@@ -611,3 +611,80 @@ TEST_CASE("uniforms can be read and written to", "[uniform]") {
    });
 }
 
+TEST_CASE("deferred uniforms are uploaded once, when flushed", "[uniform]") {
+   auto engine = doge::engine{};
+   auto program = doge::shader_binary{{
+      std::make_pair(doge::shader_source::vertex, "test.uniform.vert.glsl"),
+      std::make_pair(doge::shader_source::fragment, "test.uniform.frag.glsl")}};
+
+   program.use([&program]{
+      auto a = doge::uniform<GLfloat>{program, "f.a", 1.0f};
+      doge::uniform_uploads::mode(doge::uniform_upload::deferred);
+
+      a = 2.0f;
+      a += 3.0f;
+      CHECK(a == 5.0f);
+      CHECK(static_cast<GLfloat>(doge::uniform<const GLfloat>{program, "f.a"}) == 1.0f);
+
+      auto b = std::move(a);
+      doge::uniform_uploads::flush();
+      check_is_same_on_device(b, program, "f.a");
+
+      doge::uniform_uploads::mode(doge::uniform_upload::immediate);
+   });
+}
+
+TEST_CASE("moving a dirty uniform leaves nothing stale to upload", "[uniform]") {
+   auto engine = doge::engine{};
+   auto program = doge::shader_binary{{
+      std::make_pair(doge::shader_source::vertex, "test.uniform.vert.glsl"),
+      std::make_pair(doge::shader_source::fragment, "test.uniform.frag.glsl")}};
+
+   program.use([&program]{
+      auto const on_device = [&program](char const* const name) {
+         return static_cast<GLfloat>(doge::uniform<const GLfloat>{program, name});
+      };
+
+      auto a = doge::uniform<GLfloat>{program, "f.a", 1.0f};
+      auto b = doge::uniform<GLfloat>{program, "f.b", 2.0f};
+      auto const c = doge::uniform<GLfloat>{program, "f.c", 3.0f};
+      doge::uniform_uploads::mode(doge::uniform_upload::deferred);
+
+      // A uniform<T const> can't upload later, so the pending value is uploaded by the move.
+      a = 4.0f;
+      auto const read_only = doge::uniform<const GLfloat>{std::move(a)};
+      CHECK(static_cast<GLfloat>(read_only) == 4.0f);
+      CHECK(on_device("f.a") == 4.0f);
+
+      b = 5.0f;
+      auto const moved = std::move(b);
+      CHECK(on_device("f.b") == 2.0f);
+
+      // Neither moved-from uniform may upload its zeroed location and value.
+      doge::uniform_uploads::flush();
+      CHECK(on_device("f.a") == 4.0f);
+      CHECK(on_device("f.b") == 5.0f);
+      CHECK(on_device("f.c") == 3.0f);
+      CHECK(gl::GetError() == gl::NO_ERROR_);
+
+      doge::uniform_uploads::mode(doge::uniform_upload::immediate);
+   });
+}
+
+TEST_CASE("program reflection agrees with glGetUniformLocation", "[uniform]") {
+   auto engine = doge::engine{};
+   auto program = doge::shader_binary{{
+      std::make_pair(doge::shader_source::vertex, "test.uniform.vert.glsl"),
+      std::make_pair(doge::shader_source::fragment, "test.uniform.frag.glsl")}};
+
+   for (auto const name : {"f.a", "i.b", "u.c", "v2.a", "m4x4.c", "dne", "bad_type"}) {
+      auto const* const u = program.reflection().uniform(name);
+      auto const expected = gl::GetUniformLocation(static_cast<GLuint>(program), name);
+      CHECK((u != nullptr ? u->location : -1) == expected);
+   }
+
+   constexpr auto hashed = doge::resource_name{"f.a"};
+   static_assert(hashed.hash() == doge::resource_name::hash("f.a"));
+   CHECK(program.reflection().uniform(hashed) == program.reflection().uniform("f.a"));
+}
+
@@ -0,0 +1,44 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/gl/uniform_block.hpp>
+#include <array>
+#include <cstddef>
+#include <glm/mat3x3.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace {
+   using members = doge::std_layout_tuple<GLfloat, glm::vec2, glm::vec3, GLfloat,
+      std::array<GLfloat, 2>, glm::mat3, glm::vec4, bool>;
+} // namespace <anonymous>
+
+TEST_CASE("std140 offsets follow the GLSL rules")
+{
+   using block = doge::uniform_block<members>;
+   constexpr auto expected = std::array<std::size_t, 8>{0, 8, 16, 28, 32, 64, 112, 128};
+   CHECK(block::offsets == expected);
+   CHECK(block::size == 144);
+}
+
+TEST_CASE("std430 doesn't round arrays up to a vec4")
+{
+   using block = doge::storage_block<members>;
+   constexpr auto expected = std::array<std::size_t, 8>{0, 8, 16, 28, 32, 48, 96, 112};
+   CHECK(block::offsets == expected);
+   CHECK(block::size == 128);
+}
@@ -0,0 +1,107 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/engine.hpp>
+#include <doge/gl/direct_state_access.hpp>
+#include <doge/gl/vertex_array.hpp>
+#include <doge/types.hpp>
+#include <vector>
+
+using doge::basic_buffer_usage;
+
+TEST_CASE("matrices fill a location per column")
+{
+   using doge::detail::vertex_format;
+   static_assert(vertex_format<doge::vec3, doge::vec3, doge::vec2>::locations == 3);
+   static_assert(vertex_format<doge::mat4>::locations == 4);
+   static_assert(vertex_format<doge::mat3x2, GLfloat>::locations == 4);
+}
+
+TEST_CASE("instance attributes follow the vertex attributes, and advance per instance")
+{
+   auto engine = doge::engine{};
+   for (auto const dsa : {false, true}) {
+      doge::direct_state_access::enabled(dsa);
+      auto const vertices = std::vector<doge::std_layout_tuple<doge::vec3, doge::vec2>>(3);
+      auto const models = std::vector<doge::std_layout_tuple<doge::mat4>>(2);
+      auto mesh = doge::vertex_array_buffer<basic_buffer_usage::static_draw, doge::vec3,
+         doge::vec2>{vertices};
+      auto const instances = doge::instance_buffer<basic_buffer_usage::static_draw, doge::mat4>{
+         models};
+      CHECK(instances.size() == 2);
+
+      mesh.attach(instances);
+      mesh.bind([&instances]{
+         auto const attribute = [](GLuint const location, GLenum const name) {
+            auto result = GLint{};
+            gl::GetVertexAttribiv(location, name, &result);
+            return result;
+         };
+
+         CHECK(attribute(1, gl::VERTEX_ATTRIB_ARRAY_DIVISOR) == 0);
+         for (auto location = GLuint{2}; location < 6; ++location) {
+            CHECK(attribute(location, gl::VERTEX_ATTRIB_ARRAY_ENABLED));
+            CHECK(attribute(location, gl::VERTEX_ATTRIB_ARRAY_DIVISOR) == 1);
+            CHECK(attribute(location, gl::VERTEX_ATTRIB_ARRAY_SIZE) == 4);
+            CHECK(attribute(location, gl::VERTEX_ATTRIB_ARRAY_BUFFER_BINDING)
+               == gsl::narrow_cast<GLint>(instances.get()));
+         }
+         CHECK(not attribute(6, gl::VERTEX_ATTRIB_ARRAY_ENABLED));
+      });
+   }
+}
+
+TEST_CASE("each stream feeds its own attribute from its own buffer")
+{
+   auto engine = doge::engine{};
+   for (auto const dsa : {false, true}) {
+      doge::direct_state_access::enabled(dsa);
+      auto const positions = std::vector<doge::vec3>(3);
+      auto const coordinates = std::vector<doge::vec2>(3);
+      auto mesh = doge::vertex_stream_buffer<basic_buffer_usage::dynamic_draw, doge::vec3,
+         doge::vec2>{positions, coordinates};
+      CHECK(mesh.size() == 3);
+
+      mesh.bind([]{
+         auto const attribute = [](GLuint const location, GLenum const name) {
+            auto result = GLint{};
+            gl::GetVertexAttribiv(location, name, &result);
+            return result;
+         };
+
+         CHECK(attribute(0, gl::VERTEX_ATTRIB_ARRAY_SIZE) == 3);
+         CHECK(attribute(1, gl::VERTEX_ATTRIB_ARRAY_SIZE) == 2);
+         CHECK(attribute(0, gl::VERTEX_ATTRIB_ARRAY_BUFFER_BINDING)
+            != attribute(1, gl::VERTEX_ATTRIB_ARRAY_BUFFER_BINDING));
+      });
+   }
+}
+
+TEST_CASE("each level of detail is drawn from its own range of the element buffer")
+{
+   auto engine = doge::engine{};
+   auto mesh = doge::lod_mesh<doge::vec3>{};
+   mesh.vertices.resize(4);
+   mesh.elements = {0, 1, 2, 0, 2, 3, 0, 1, 2};
+   mesh.lods = {{0, 6, 0.0f}, {6, 3, 0.5f}};
+
+   auto const buffer = doge::make_vertex_element_buffer(mesh);
+   auto const draw = buffer.as_draw_call(mesh.lods[1], 2);
+   CHECK(draw.count == 3);
+   CHECK(draw.first == gsl::narrow_cast<GLintptr>(6 * sizeof(GLushort)));
+   CHECK(draw.index_type == gl::UNSIGNED_SHORT);
+   CHECK(draw.instances == 2);
+}
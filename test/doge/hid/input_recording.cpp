@@ -0,0 +1,137 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/hid/input_recording.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+
+namespace {
+   namespace hid = doge::hid;
+   using hid::input_event;
+   using hid::key_state;
+
+   // Reports events the same way that the GLFW callbacks do.
+   struct fake_glfw : hid::hid {
+      static void report(input_event const& e) noexcept
+      {
+         if (accept(e))
+            doge::hid::apply(e);
+      }
+   };
+
+   void reset() noexcept
+   {
+      hid::keyboard::key(GLFW_KEY_A, key_state::up);
+      hid::keyboard::key(GLFW_KEY_UNKNOWN, key_state::up);
+      fake_glfw::report({input_event::device::cursor, 0, 0, 0, {0.0f, 0.0f}});
+      fake_glfw::report({input_event::device::scroll, 0, 0, 0, {0.0f, 0.0f}});
+      hid::mouse::update();
+   }
+
+   void write_recording(std::string const& path, std::initializer_list<std::uint8_t> const records)
+   {
+      auto out = std::ofstream{path, std::ios::binary};
+      out.write("dogeinpt", 8);
+      out.put(1);
+      for (auto const byte : records)
+         out.put(static_cast<char>(byte));
+   }
+
+   constexpr auto path = "test.doge.hid.input_recording.bin";
+} // namespace <anonymous>
+
+TEST_CASE("replaying a recording reproduces the input that was recorded")
+{
+   reset();
+   {
+      auto recorder = hid::input_recorder{path};
+      fake_glfw::report({input_event::device::cursor, 0, 0, 0, {10.0f, 20.0f}});
+
+      recorder.frame(0.25);
+      fake_glfw::report({input_event::device::keyboard, GLFW_KEY_UNKNOWN, GLFW_PRESS, 0});
+      fake_glfw::report({input_event::device::mouse_button, GLFW_MOUSE_BUTTON_RIGHT, GLFW_PRESS,
+         0});
+      fake_glfw::report({input_event::device::keyboard, GLFW_KEY_A, GLFW_PRESS, GLFW_MOD_SHIFT});
+
+      recorder.frame(0.5);
+      fake_glfw::report({input_event::device::keyboard, GLFW_KEY_A, GLFW_RELEASE, 0});
+      fake_glfw::report({input_event::device::scroll, 0, 0, 0, {0.0f, -1.0f}});
+   }
+
+   reset();
+   {
+      auto player = hid::input_player{path};
+      CHECK(not hid::hid::live());
+
+      // Live input is ignored while the recording plays.
+      fake_glfw::report({input_event::device::cursor, 0, 0, 0, {-1.0f, -1.0f}});
+      CHECK(hid::mouse::cursor(hid::mouse::current) == glm::vec2{0.0f, 0.0f});
+
+      REQUIRE(player.next_frame() == 0.25);
+      CHECK(hid::mouse::cursor(hid::mouse::current) == glm::vec2{10.0f, 20.0f});
+      CHECK(hid::keyboard::key(GLFW_KEY_A) == key_state::up);
+
+      player.poll_events();
+      CHECK(hid::keyboard::key(GLFW_KEY_A) == key_state::press);
+      CHECK(hid::keyboard::key(GLFW_KEY_UNKNOWN) == key_state::press);
+      CHECK(hid::hid::shift());
+
+      REQUIRE(player.next_frame() == 0.5);
+      player.poll_events();
+      CHECK(hid::keyboard::key(GLFW_KEY_A) == key_state::release);
+      CHECK(not hid::hid::shift());
+      CHECK(hid::mouse::scroll(hid::mouse::current) == glm::vec2{0.0f, -1.0f});
+
+      CHECK(not player.next_frame());
+   }
+
+   CHECK(hid::hid::live());
+   std::remove(path);
+}
+
+TEST_CASE("a recording with a key or button that doesn't exist is rejected")
+{
+   SECTION("key past the end")
+   {
+      write_recording(path, {1, (GLFW_KEY_LAST + 100) & 0xff, (GLFW_KEY_LAST + 100) >> 8, 1, 0});
+      CHECK_THROWS_AS(hid::input_player{path}, std::runtime_error);
+   }
+
+   SECTION("key before GLFW_KEY_UNKNOWN")
+   {
+      write_recording(path, {1, 0xfe, 0xff, 1, 0});
+      CHECK_THROWS_AS(hid::input_player{path}, std::runtime_error);
+   }
+
+   SECTION("mouse button past the end")
+   {
+      write_recording(path, {2, GLFW_MOUSE_BUTTON_LAST + 1, 0, 1, 0});
+      CHECK_THROWS_AS(hid::input_player{path}, std::runtime_error);
+   }
+
+   SECTION("negative mouse button")
+   {
+      write_recording(path, {2, 0xff, 0xff, 1, 0});
+      CHECK_THROWS_AS(hid::input_player{path}, std::runtime_error);
+   }
+
+   CHECK(hid::hid::live());
+   std::remove(path);
+}
@@ -0,0 +1,111 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/utility/dirty_ranges.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+   std::vector<std::byte> bytes(std::size_t const n, int const value)
+   {
+      return std::vector<std::byte>(n, static_cast<std::byte>(value));
+   }
+
+   std::vector<std::pair<std::size_t, std::vector<std::byte>>> contents(
+      doge::dirty_ranges const& d)
+   {
+      auto result = std::vector<std::pair<std::size_t, std::vector<std::byte>>>{};
+      d.for_each([&result](std::size_t const offset, gsl::span<std::byte const> const b) {
+         result.emplace_back(offset, std::vector<std::byte>(b.begin(), b.end()));
+      });
+      return result;
+   }
+} // namespace <anonymous>
+
+TEST_CASE("disjoint writes are kept apart, in order of offset")
+{
+   auto d = doge::dirty_ranges{};
+   d.add(20, bytes(4, 2));
+   d.add(0, bytes(4, 1));
+   d.add(40, bytes(8, 3));
+
+   CHECK(d.size() == 3);
+   CHECK(d.bytes() == 16);
+   CHECK(d.first() == 0);
+   CHECK(d.last() == 48);
+
+   auto const c = contents(d);
+   CHECK(c[0] == std::make_pair(std::size_t{0}, bytes(4, 1)));
+   CHECK(c[1] == std::make_pair(std::size_t{20}, bytes(4, 2)));
+   CHECK(c[2] == std::make_pair(std::size_t{40}, bytes(8, 3)));
+}
+
+TEST_CASE("adjacent writes are merged")
+{
+   auto d = doge::dirty_ranges{};
+   d.add(4, bytes(4, 2));
+   d.add(0, bytes(4, 1));
+   d.add(8, bytes(4, 3));
+
+   REQUIRE(d.size() == 1);
+   auto expected = bytes(4, 1);
+   expected.insert(expected.end(), 4, std::byte{2});
+   expected.insert(expected.end(), 4, std::byte{3});
+   CHECK(contents(d)[0] == std::make_pair(std::size_t{0}, expected));
+}
+
+TEST_CASE("overlapping writes are merged, and newer bytes win")
+{
+   auto d = doge::dirty_ranges{};
+   d.add(0, bytes(4, 1));
+   d.add(10, bytes(4, 2));
+   d.add(2, bytes(10, 3));
+
+   REQUIRE(d.size() == 1);
+   CHECK(d.first() == 0);
+   CHECK(d.last() == 14);
+
+   auto expected = bytes(2, 1);
+   expected.insert(expected.end(), 10, std::byte{3});
+   expected.insert(expected.end(), 2, std::byte{2});
+   CHECK(contents(d)[0] == std::make_pair(std::size_t{0}, expected));
+}
+
+TEST_CASE("a write inside a staged range only replaces the bytes it covers")
+{
+   auto d = doge::dirty_ranges{};
+   d.add(0, bytes(8, 1));
+   d.add(2, bytes(2, 2));
+
+   REQUIRE(d.size() == 1);
+   auto expected = bytes(8, 1);
+   expected[2] = expected[3] = std::byte{2};
+   CHECK(contents(d)[0] == std::make_pair(std::size_t{0}, expected));
+}
+
+TEST_CASE("empty writes and clear leave nothing staged")
+{
+   auto d = doge::dirty_ranges{};
+   d.add(0, {});
+   CHECK(d.empty());
+
+   d.add(0, bytes(4, 1));
+   d.add(8, bytes(4, 1));
+   d.clear();
+   CHECK(d.empty());
+   CHECK(d.bytes() == 0);
+}
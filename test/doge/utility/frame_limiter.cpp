@@ -0,0 +1,154 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/utility/frame_limiter.hpp>
+#include <vector>
+
+namespace {
+   // A clock that only moves when the limiter waits on it, or when a test does the frame's work.
+   struct fake_clock {
+      static inline double time = 0.0;
+      static inline double overshoot = 0.0;
+      static inline std::vector<double> sleeps;
+      static inline int yields = 0;
+
+      static double now() noexcept
+      {
+         return time;
+      }
+
+      static void sleep_for(double const s)
+      {
+         sleeps.push_back(s);
+         time += s + overshoot;
+      }
+
+      static void yield() noexcept
+      {
+         ++yields;
+         time += 0.0001;
+      }
+
+      static void reset(double const start, double const sleep_overshoot = 0.0)
+      {
+         time = start;
+         overshoot = sleep_overshoot;
+         sleeps.clear();
+         yields = 0;
+      }
+   };
+
+   using limiter = doge::basic_frame_limiter<fake_clock>;
+} // namespace <anonymous>
+
+TEST_CASE("an unlimited limiter never waits")
+{
+   fake_clock::reset(1.0);
+   auto l = limiter{};
+   CHECK(not l.limited());
+
+   l.pace();
+   l.pace();
+   CHECK(fake_clock::time == 1.0);
+   CHECK(fake_clock::sleeps.empty());
+   CHECK(fake_clock::yields == 0);
+}
+
+TEST_CASE("immediate frames sleep until spin_threshold before the next period")
+{
+   fake_clock::reset(1.0);
+   auto l = limiter{100.0, limiter::mode::immediate, 0.002};
+   REQUIRE(l.period() == Approx(0.01));
+
+   // The first frame has no schedule to keep to, so it starts straight away.
+   l.pace();
+   CHECK(fake_clock::sleeps.empty());
+   CHECK(fake_clock::time == 1.0);
+
+   fake_clock::time += 0.003;
+   l.pace();
+   REQUIRE(fake_clock::sleeps.size() == 1);
+   CHECK(fake_clock::sleeps[0] == Approx(0.005));
+   CHECK(fake_clock::yields > 0);
+   CHECK(fake_clock::time >= 1.01);
+   CHECK(fake_clock::time < 1.0101 + 1.0e-9);
+
+   CHECK(l.pacing().work == Approx(0.003));
+   CHECK(l.pacing().deadline_error == Approx(-0.007));
+   CHECK(l.pacing().wake_error < 0.0001 + 1.0e-9);
+}
+
+TEST_CASE("a sleep that overshoots the target isn't followed by a spin")
+{
+   fake_clock::reset(1.0, 0.004);
+   auto l = limiter{100.0, limiter::mode::immediate, 0.002};
+   l.pace();
+
+   fake_clock::time += 0.003;
+   l.pace();
+   CHECK(fake_clock::yields == 0);
+   CHECK(fake_clock::time == Approx(1.012));
+   CHECK(l.pacing().wake_error == Approx(0.002));
+}
+
+TEST_CASE("just_in_time frames start as late as the slowest recent frame allows")
+{
+   fake_clock::reset(1.0);
+   auto l = limiter{100.0, limiter::mode::just_in_time, 0.002, 0.001};
+
+   // With no frames to go by, the first one is released safety_margin before its deadline.
+   l.pace();
+   REQUIRE(fake_clock::sleeps.size() == 1);
+   CHECK(fake_clock::sleeps[0] == Approx(1.009 - 0.002 - 1.0));
+   CHECK(fake_clock::time >= 1.009);
+   CHECK(fake_clock::time < 1.0091 + 1.0e-9);
+
+   // The next deadline is 1.02, and the frame took 0.002s, so the next frame is released at
+   // 1.02 - 0.002 - 0.001.
+   auto const finished = fake_clock::time + 0.002;
+   fake_clock::time = finished;
+   l.pace();
+   REQUIRE(fake_clock::sleeps.size() == 2);
+   CHECK(fake_clock::sleeps[1] == Approx(1.017 - 0.002 - finished));
+   CHECK(fake_clock::time >= 1.017);
+   CHECK(fake_clock::time < 1.0171 + 1.0e-9);
+
+   // A quicker frame doesn't bring the release forward, since the slowest one still counts.
+   fake_clock::time += 0.001;
+   l.pace();
+   CHECK(fake_clock::time >= 1.027);
+   CHECK(fake_clock::time < 1.0271 + 1.0e-9);
+}
+
+TEST_CASE("missing a deadline by more than a period restarts the schedule")
+{
+   fake_clock::reset(1.0);
+   auto l = limiter{100.0, limiter::mode::immediate, 0.002};
+   l.pace();
+
+   // The frame was due at 1.01, but it finishes at 1.05. Catching up would release the next frame
+   // immediately; restarting releases it straight away too, but its deadline moves to 1.06.
+   fake_clock::time += 0.05;
+   l.pace();
+   CHECK(fake_clock::sleeps.empty());
+   CHECK(l.pacing().deadline_error == Approx(0.04));
+
+   fake_clock::time += 0.001;
+   l.pace();
+   CHECK(l.pacing().deadline_error == Approx(1.051 - 1.06));
+   REQUIRE(fake_clock::sleeps.size() == 1);
+   CHECK(fake_clock::sleeps[0] == Approx(1.06 - 0.002 - 1.051));
+}
@@ -0,0 +1,100 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/gl/gl_error.hpp>
+#include <doge/utility/headless_context.hpp>
+#include <doge/utility/screen_data.hpp>
+#include <EGL/egl.h>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+   std::array<std::uint8_t, 4> clear_and_read(float const r, float const g, float const b)
+   {
+      gl::ClearColor(r, g, b, 1.0f);
+      gl::Clear(gl::COLOR_BUFFER_BIT);
+
+      auto pixel = std::array<std::uint8_t, 4>{};
+      gl::ReadPixels(0, 0, 1, 1, gl::RGBA, gl::UNSIGNED_BYTE, pixel.data());
+      return pixel;
+   }
+
+   // EGL_CONTEXT_OPENGL_DEBUG, which the headless context asks for debug contexts with, is new in
+   // EGL 1.5.
+   bool supports_debug_contexts() noexcept
+   {
+      auto major = 0;
+      auto minor = 0;
+      auto const* const version = eglQueryString(eglGetCurrentDisplay(), EGL_VERSION);
+      return version != nullptr && std::sscanf(version, "%d.%d", &major, &minor) == 2
+         && (major > 1 || (major == 1 && minor >= 5));
+   }
+} // namespace <anonymous>
+
+TEST_CASE("a headless context renders into its offscreen framebuffer")
+{
+   auto context = doge::headless_context{16, 16};
+
+   auto major = GLint{0};
+   auto minor = GLint{0};
+   gl::GetIntegerv(gl::MAJOR_VERSION, &major);
+   gl::GetIntegerv(gl::MINOR_VERSION, &minor);
+   CHECK((major > 4 || (major == 4 && minor >= 3)));
+
+   auto bound = GLint{0};
+   gl::GetIntegerv(gl::FRAMEBUFFER_BINDING, &bound);
+   CHECK(static_cast<GLuint>(bound) == context.framebuffer());
+
+   CHECK(clear_and_read(1.0f, 0.0f, 1.0f) == std::array<std::uint8_t, 4>{255, 0, 255, 255});
+   CHECK(clear_and_read(0.0f, 1.0f, 0.0f) == std::array<std::uint8_t, 4>{0, 255, 0, 255});
+   CHECK(gl::GetError() == gl::NO_ERROR_);
+}
+
+TEST_CASE("a headless context provides debug output when it's the default policy")
+{
+   auto context = doge::headless_context{16, 16};
+   constexpr auto debug = doge::default_error_policy == doge::error_policy::debug_output;
+   if (debug && supports_debug_contexts()) {
+      auto flags = GLint{0};
+      gl::GetIntegerv(gl::CONTEXT_FLAGS, &flags);
+      CHECK((flags & gl::CONTEXT_FLAG_DEBUG_BIT) != 0);
+   }
+
+   // Without debug output, error checking falls back to checking once per frame.
+   doge::error_checking::policy(doge::default_error_policy);
+   if (debug && gl::DebugMessageCallback != nullptr)
+      CHECK(doge::error_checking::policy() == doge::error_policy::debug_output);
+   else if (debug)
+      CHECK(doge::error_checking::policy() == doge::error_policy::per_frame);
+   else
+      CHECK(doge::error_checking::policy() == doge::default_error_policy);
+}
+
+TEST_CASE("a headless screen stays open until it's closed")
+{
+   auto screen = doge::screen_data{doge::screen_data::backend_t::headless, 16, 16, 0, false};
+   REQUIRE(screen.headless());
+   CHECK(screen.window() == nullptr);
+   CHECK(screen.open());
+
+   screen.swap_buffers();
+   CHECK(screen.open());
+   CHECK(clear_and_read(0.0f, 0.0f, 1.0f) == std::array<std::uint8_t, 4>{0, 0, 255, 255});
+
+   screen.close();
+   CHECK(not screen.open());
+}
@@ -0,0 +1,80 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/utility/job_system.hpp>
+#include <atomic>
+#include <experimental/ranges/algorithm>
+#include <numeric>
+#include <vector>
+
+namespace ranges = std::experimental::ranges;
+
+TEST_CASE("parallel_for visits every element exactly once")
+{
+   auto jobs = doge::job_system{3};
+   auto values = std::vector<int>(10'000);
+   std::iota(ranges::begin(values), ranges::end(values), 0);
+
+   jobs.parallel_for(values, [](int& x) { x *= 2; }, 100);
+   for (auto i = 0; i < 10'000; ++i)
+      CHECK(values[i] == 2 * i);
+}
+
+TEST_CASE("parallel_for runs on the calling thread when there are no workers")
+{
+   auto jobs = doge::job_system{0};
+   CHECK(jobs.concurrency() == 1);
+
+   auto count = 0;
+   auto const values = std::vector<int>(1'000);
+   jobs.parallel_for(ranges::begin(values), ranges::end(values), [&count](int) { ++count; });
+   CHECK(count == 1'000);
+}
+
+TEST_CASE("continuations run after their parent")
+{
+   auto jobs = doge::job_system{2};
+   auto order = std::atomic<int>{0};
+   auto first = -1;
+   auto second = -1;
+   auto third = -1;
+
+   auto const a = jobs.spawn([&]{ first = order++; });
+   auto const b = jobs.then(a, [&]{ second = order++; });
+   auto const c = jobs.then(b, [&]{ third = order++; });
+   jobs.wait(c);
+
+   CHECK(a.done());
+   CHECK(b.done());
+   CHECK(first == 0);
+   CHECK(second == 1);
+   CHECK(third == 2);
+}
+
+TEST_CASE("wait_for_frame waits for jobs spawned by other jobs")
+{
+   auto jobs = doge::job_system{3};
+   auto count = std::atomic<int>{0};
+   for (auto i = 0; i < 100; ++i) {
+      jobs.spawn([&]{
+         jobs.spawn([&]{ ++count; });
+         ++count;
+      });
+   }
+
+   jobs.wait_for_frame();
+   CHECK(count == 200);
+}
@@ -0,0 +1,259 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/utility/mesh_optimisation.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace {
+   using vertex = doge::std_layout_tuple<float, float, float>;
+
+   // The twelve triangles of a unit cube, with a normal per face, as a triangle soup.
+   std::vector<doge::std_layout_tuple<vertex, vertex>> cube_soup()
+   {
+      auto result = std::vector<doge::std_layout_tuple<vertex, vertex>>{};
+      for (auto axis = 0; axis < 3; ++axis) {
+         for (auto const side : {0.0f, 1.0f}) {
+            auto corner = [axis, side](float const u, float const v) {
+               auto p = std::array<float, 3>{};
+               p[axis] = side;
+               p[(axis + 1) % 3] = u;
+               p[(axis + 2) % 3] = v;
+               return vertex{p[0], p[1], p[2]};
+            };
+
+            auto n = std::array<float, 3>{};
+            n[axis] = side == 0.0f ? -1.0f : 1.0f;
+            auto const normal = vertex{n[0], n[1], n[2]};
+            for (auto const [u, v] : {std::array{0.0f, 0.0f}, std::array{1.0f, 0.0f},
+               std::array{1.0f, 1.0f}, std::array{0.0f, 0.0f}, std::array{1.0f, 1.0f},
+               std::array{0.0f, 1.0f}}) {
+               result.emplace_back(corner(u, v), normal);
+            }
+         }
+      }
+
+      return result;
+   }
+
+   // A size by size grid of quads, with its triangles in row order.
+   std::vector<GLuint> grid(GLuint const size)
+   {
+      auto result = std::vector<GLuint>{};
+      for (auto y = GLuint{0}; y < size; ++y) {
+         for (auto x = GLuint{0}; x < size; ++x) {
+            auto const corner = y * (size + 1) + x;
+            result.insert(result.end(), {corner, corner + 1, corner + size + 2,
+               corner, corner + size + 2, corner + size + 1});
+         }
+      }
+
+      return result;
+   }
+
+   using position = std::array<float, 3>;
+
+   // The positions of grid(size), spread over the unit square, and raised by height.
+   template <typename F>
+   std::vector<position> grid_positions(GLuint const size, F const& height)
+   {
+      auto result = std::vector<position>{};
+      for (auto y = GLuint{0}; y <= size; ++y) {
+         for (auto x = GLuint{0}; x <= size; ++x) {
+            auto const u = static_cast<float>(x) / size;
+            auto const v = static_cast<float>(y) / size;
+            result.push_back({u, v, height(u, v)});
+         }
+      }
+
+      return result;
+   }
+
+   float flat(float, float) noexcept
+   {
+      return 0.0f;
+   }
+
+   bool uses(std::vector<GLuint> const& elements, GLuint const v)
+   {
+      return std::find(elements.begin(), elements.end(), v) != elements.end();
+   }
+
+   std::vector<std::array<GLuint, 3>> sorted_triangles(std::vector<GLuint> const& elements)
+   {
+      auto result = std::vector<std::array<GLuint, 3>>{};
+      for (auto i = std::size_t{0}; i < elements.size(); i += 3)
+         result.push_back({elements[i], elements[i + 1], elements[i + 2]});
+      std::sort(result.begin(), result.end());
+      return result;
+   }
+} // namespace <anonymous>
+
+TEST_CASE("identical vertices are merged, and numbered in the order that they appear")
+{
+   auto const soup = std::vector<vertex>{vertex{0, 0, 0}, vertex{1, 0, 0}, vertex{0, 0, 0},
+      vertex{2, 0, 0}, vertex{1, 0, 0}};
+   auto const indices = doge::index_vertices(gsl::as_bytes(gsl::span<vertex const>{soup}),
+      sizeof(vertex));
+   CHECK(indices == std::vector<GLuint>{0, 1, 0, 2, 1});
+}
+
+TEST_CASE("a cube's soup becomes 24 vertices, or 8 without its normals")
+{
+   auto const soup = cube_soup();
+   REQUIRE(soup.size() == 36);
+
+   auto const mesh = doge::optimise_mesh(soup);
+   CHECK(mesh.statistics.soup_vertices == 36);
+   CHECK(mesh.statistics.unique_vertices == 24);
+   CHECK(mesh.vertices.size() == 24);
+   REQUIRE(mesh.elements.size() == 36);
+   for (auto i = std::size_t{0}; i < soup.size(); ++i)
+      CHECK(std::memcmp(&mesh.vertices[mesh.elements[i]], &soup[i], sizeof(soup[i])) == 0);
+
+   auto positions = std::vector<vertex>{};
+   for (auto const& v : soup)
+      positions.push_back(doge::get<0>(v));
+   CHECK(doge::optimise_mesh(positions).vertices.size() == 8);
+}
+
+TEST_CASE("a triangle soup misses the cache three times per triangle")
+{
+   auto elements = std::vector<GLuint>(36);
+   std::iota(elements.begin(), elements.end(), GLuint{0});
+   CHECK(doge::average_cache_miss_ratio(elements, 36) == Approx(3.0));
+}
+
+TEST_CASE("reordering for the cache keeps every triangle, and doesn't miss more often")
+{
+   constexpr auto size = GLuint{32};
+   constexpr auto vertex_count = (size + 1) * (size + 1);
+   auto const before = grid(size);
+   auto after = before;
+   doge::optimise_vertex_cache(after, vertex_count);
+
+   CHECK(sorted_triangles(after) == sorted_triangles(before));
+   auto const acmr_before = doge::average_cache_miss_ratio(before, vertex_count);
+   auto const acmr_after = doge::average_cache_miss_ratio(after, vertex_count);
+   CHECK(acmr_after < acmr_before);
+   CHECK(acmr_after < 0.8);
+}
+
+TEST_CASE("reordering for fetching numbers vertices in the order that they're first used")
+{
+   auto elements = std::vector<GLuint>{4, 2, 0, 2, 4, 1};
+   auto const remap = doge::optimise_vertex_fetch(elements, 6);
+   CHECK(elements == std::vector<GLuint>{0, 1, 2, 1, 0, 3});
+   CHECK(remap == std::vector<GLuint>{2, 3, 1, 4, 0, 5});
+}
+
+TEST_CASE("simplifying a flat grid removes triangles without moving its surface")
+{
+   constexpr auto size = GLuint{16};
+   auto const elements = grid(size);
+   auto const positions = grid_positions(size, flat);
+   auto const result = doge::simplify(elements, positions, elements.size() / 4);
+
+   CHECK(result.elements.size() <= elements.size() / 4);
+   CHECK(result.elements.size() % 3 == 0);
+   CHECK(result.error < 1e-3f);
+
+   // The corners of the border are still there, so the grid still covers the whole square.
+   for (auto const corner : {GLuint{0}, size, size * (size + 1), (size + 1) * (size + 1) - 1})
+      CHECK(uses(result.elements, corner));
+}
+
+TEST_CASE("vertices on a border or a seam are never moved")
+{
+   constexpr auto size = GLuint{8};
+   auto elements = grid(size);
+   auto positions = grid_positions(size, flat);
+
+   // Give the right half of the grid its own copy of the middle column, as a UV seam would.
+   auto const first_copy = gsl::narrow_cast<GLuint>(positions.size());
+   for (auto y = GLuint{0}; y <= size; ++y)
+      positions.push_back(positions[y * (size + 1) + size / 2]);
+   for (auto i = std::size_t{0}; i < elements.size(); i += 3) {
+      auto const right = std::any_of(&elements[i], &elements[i] + 3, [](GLuint const v) {
+         return v % (size + 1) > size / 2; });
+      for (auto corner = i; right && corner < i + 3; ++corner) {
+         if (elements[corner] % (size + 1) == size / 2)
+            elements[corner] = first_copy + elements[corner] / (size + 1);
+      }
+   }
+
+   auto const result = doge::simplify(elements, positions, 0);
+   CHECK(result.elements.size() < elements.size());
+   for (auto y = GLuint{0}; y <= size; ++y) {
+      CHECK(uses(result.elements, y * (size + 1)));
+      CHECK(uses(result.elements, y * (size + 1) + size / 2));
+      CHECK(uses(result.elements, first_copy + y));
+      CHECK(uses(result.elements, y * (size + 1) + size));
+   }
+}
+
+TEST_CASE("a cube with a normal per face is all seams, so it can't be simplified")
+{
+   auto const mesh = doge::optimise_mesh(cube_soup());
+   auto positions = std::vector<position>{};
+   for (auto const& v : mesh.vertices) {
+      auto const& p = doge::get<0>(v);
+      positions.push_back({doge::get<0>(p), doge::get<1>(p), doge::get<2>(p)});
+   }
+
+   CHECK(doge::simplify(mesh.elements, positions, 0).elements == mesh.elements);
+}
+
+TEST_CASE("each level of detail has fewer triangles, and more error, than the one before it")
+{
+   constexpr auto size = GLuint{32};
+   auto mesh = doge::indexed_mesh<position>{};
+   for (auto const& p : grid_positions(size, [](float const u, float const v) {
+      return 0.1f * std::sin(6.0f * u) * std::cos(6.0f * v); })) {
+      mesh.vertices.emplace_back(p);
+   }
+   mesh.elements = grid(size);
+
+   auto const lods = doge::make_lods(mesh, 4);
+   REQUIRE(lods.lods.size() == 4);
+   CHECK(lods.vertices.size() == mesh.vertices.size());
+   CHECK(lods.lods[0].first == 0);
+   CHECK(lods.lods[0].count == mesh.elements.size());
+   CHECK(lods.lods[0].error == 0.0f);
+   for (auto i = std::size_t{1}; i < lods.lods.size(); ++i) {
+      auto const& previous = lods.lods[i - 1];
+      CHECK(lods.lods[i].first == previous.first + previous.count);
+      CHECK(lods.lods[i].count <= previous.count / 2);
+      CHECK(lods.lods[i].error > previous.error);
+   }
+
+   auto const& last = lods.lods.back();
+   CHECK(last.first + last.count == lods.elements.size());
+}
+
+TEST_CASE("the level of detail that's picked is the coarsest one whose error can't be seen")
+{
+   auto const lods = std::vector<doge::mesh_lod>{{0, 300, 0.0f}, {300, 150, 0.01f},
+      {450, 75, 0.1f}};
+   CHECK(doge::select_lod(lods, 1'000.0f) == 0);
+   CHECK(doge::select_lod(lods, 50.0f) == 1);
+   CHECK(doge::select_lod(lods, 5.0f) == 2);
+   CHECK(doge::select_lod(lods, 1'000.0f, 20.0f) == 1);
+}
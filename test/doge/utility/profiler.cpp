@@ -0,0 +1,118 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/utility/headless_context.hpp>
+#include <doge/utility/profiler.hpp>
+#include <cstdint>
+#include <iterator>
+
+namespace {
+   // Finishing every frame means that its queries are always ready by the time they're collected.
+   void run_frames(doge::profiler& profiler, int const frames)
+   {
+      for (auto i = 0; i < frames; ++i) {
+         profiler.begin_frame();
+         {
+            auto const outer = profiler.profile("outer");
+            auto const inner = profiler.profile("inner");
+         }
+         profiler.end_frame();
+         gl::Finish();
+      }
+   }
+} // namespace <anonymous>
+
+TEST_CASE("frames are collected frames_in_flight frames after they end")
+{
+   auto context = doge::headless_context{16, 16};
+   auto profiler = doge::profiler{};
+   CHECK(not profiler.latest());
+
+   run_frames(profiler, doge::profiler::frames_in_flight);
+   CHECK(not profiler.latest());
+
+   constexpr auto frames = 3 * doge::profiler::frames_in_flight + 1;
+   run_frames(profiler, frames - doge::profiler::frames_in_flight);
+
+   auto const history = profiler.history();
+   REQUIRE(std::size(history) == frames - doge::profiler::frames_in_flight);
+   for (auto i = std::int64_t{0}; i < static_cast<std::int64_t>(std::size(history)); ++i) {
+      auto const& frame = history[static_cast<std::size_t>(i)];
+      CHECK(frame.frame == i);
+      CHECK(frame.cpu >= 0.0);
+      CHECK(frame.gpu >= 0.0);
+
+      REQUIRE(std::size(frame.scopes) == 2);
+      CHECK(frame.scopes[0].name == "outer");
+      CHECK(frame.scopes[0].depth == 0);
+      CHECK(frame.scopes[1].name == "inner");
+      CHECK(frame.scopes[1].depth == 1);
+      CHECK(frame.scopes[0].cpu >= frame.scopes[1].cpu);
+   }
+
+   CHECK(profiler.latest()->frame == history.back().frame);
+   CHECK(profiler.dropped_frames() == 0);
+}
+
+TEST_CASE("a scope that outlives its frame is closed with that frame")
+{
+   auto context = doge::headless_context{16, 16};
+   auto profiler = doge::profiler{};
+
+   profiler.begin_frame();
+   {
+      auto const late = profiler.profile("late");
+      profiler.end_frame();
+      gl::Finish();
+
+      // Destroying late here mustn't touch the next frame, which reuses none of its scopes.
+      profiler.begin_frame();
+   }
+   {
+      auto const next = profiler.profile("next");
+   }
+   profiler.end_frame();
+   gl::Finish();
+
+   run_frames(profiler, doge::profiler::frames_in_flight);
+
+   auto const history = profiler.history();
+   REQUIRE(std::size(history) >= 2);
+
+   REQUIRE(std::size(history[0].scopes) == 1);
+   CHECK(history[0].frame == 0);
+   CHECK(history[0].scopes[0].name == "late");
+   CHECK(history[0].scopes[0].cpu >= 0.0);
+   CHECK(history[0].scopes[0].cpu <= history[0].cpu);
+
+   REQUIRE(std::size(history[1].scopes) == 1);
+   CHECK(history[1].frame == 1);
+   CHECK(history[1].scopes[0].name == "next");
+   CHECK(history[1].scopes[0].depth == 0);
+}
+
+TEST_CASE("scopes opened outside of a frame aren't recorded")
+{
+   auto context = doge::headless_context{16, 16};
+   auto profiler = doge::profiler{};
+   {
+      auto const ignored = profiler.profile("ignored");
+   }
+
+   run_frames(profiler, doge::profiler::frames_in_flight + 1);
+   REQUIRE(profiler.latest());
+   CHECK(std::size(profiler.latest()->scopes) == 2);
+}
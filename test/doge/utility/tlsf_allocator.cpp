@@ -0,0 +1,120 @@
+//
+//  Copyright 2018 Christopher Di Bella
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <catch/catch.hpp>
+#include <doge/utility/tlsf_allocator.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using doge::tlsf_allocator;
+
+TEST_CASE("allocations are disjoint, and fill the whole capacity")
+{
+   auto heap = tlsf_allocator{1'000};
+   auto const a = heap.allocate(600);
+   auto const b = heap.allocate(400);
+   REQUIRE(a);
+   REQUIRE(b);
+   CHECK(a->offset + a->size <= b->offset);
+   CHECK(heap.available() == 0);
+   CHECK(not heap.allocate(1));
+}
+
+TEST_CASE("allocations are aligned, even to sizes that aren't powers of two")
+{
+   auto heap = tlsf_allocator{10'000};
+   REQUIRE(heap.allocate(5));
+   for (auto const alignment : {12u, 32u, 20u, 7u}) {
+      auto const a = heap.allocate(100, alignment);
+      REQUIRE(a);
+      CHECK(a->offset % alignment == 0);
+      CHECK(a->size == 100);
+   }
+}
+
+TEST_CASE("freed neighbours are merged")
+{
+   auto heap = tlsf_allocator{300};
+   auto const a = heap.allocate(100);
+   auto const b = heap.allocate(100);
+   auto const c = heap.allocate(100);
+   REQUIRE((a && b && c));
+
+   heap.deallocate(*a);
+   heap.deallocate(*c);
+   CHECK(not heap.allocate(200));
+
+   heap.deallocate(*b);
+   CHECK(heap.available() == 300);
+   auto const whole = heap.allocate(300);
+   REQUIRE(whole);
+   CHECK(whole->offset == 0);
+}
+
+TEST_CASE("growing keeps existing allocations, and extends the free space at the end")
+{
+   auto heap = tlsf_allocator{100};
+   auto const a = heap.allocate(60);
+   REQUIRE(a);
+   CHECK(not heap.allocate(80));
+
+   heap.grow(200);
+   CHECK(heap.capacity() == 200);
+   auto const b = heap.allocate(140);
+   REQUIRE(b);
+   CHECK(b->offset == 60);
+
+   heap.deallocate(*a);
+   heap.deallocate(*b);
+   CHECK(heap.allocate(200));
+}
+
+TEST_CASE("random allocations never overlap, and everything is recovered when they're freed")
+{
+   constexpr auto capacity = std::size_t{1} << 20;
+   auto heap = tlsf_allocator{capacity};
+   auto live = std::vector<tlsf_allocator::allocation>{};
+   auto engine = std::mt19937{42};
+   auto size = std::uniform_int_distribution<std::size_t>{1, 4'096};
+   auto alignment = std::uniform_int_distribution<std::size_t>{1, 64};
+
+   for (auto i = 0; i < 10'000; ++i) {
+      if (not live.empty() && engine() % 3 == 0) {
+         auto const victim = engine() % live.size();
+         heap.deallocate(live[victim]);
+         live[victim] = live.back();
+         live.pop_back();
+         continue;
+      }
+
+      auto const align = alignment(engine);
+      if (auto const a = heap.allocate(size(engine), align)) {
+         CHECK(a->offset % align == 0);
+         CHECK(a->offset + a->size <= capacity);
+         live.push_back(*a);
+      }
+   }
+
+   std::sort(live.begin(), live.end(), [](auto const& x, auto const& y) {
+      return x.offset < y.offset; });
+   for (auto i = std::size_t{1}; i < live.size(); ++i)
+      CHECK(live[i - 1].offset + live[i - 1].size <= live[i].offset);
+
+   for (auto const& a : live)
+      heap.deallocate(a);
+   CHECK(heap.available() == capacity);
+   CHECK(heap.allocate(capacity));
+}